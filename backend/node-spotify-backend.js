@@ -17,12 +17,21 @@ function Player(socket, spotify, events) {
     var currentTrack = {};
     var queue = []; //TODO: this does not work when the playlist gets updated while playing
 
-    spotify.player.on(events.player_end_of_track, function() {
+    function onEndOfTrack() {
         playNextTrack();
-    });
+    }
 
-    spotify.player.on(events.player_second_in_song, function() {
+    function onSecondInSong() {
         socket.emit(events.player_second_in_song, this.currentSecond);
+    }
+
+    spotify.player.on(events.player_end_of_track, onEndOfTrack);
+    spotify.player.on(events.player_second_in_song, onSecondInSong);
+
+    //Every connection adds its own listeners, remove them when it goes away
+    socket.on('disconnect', function() {
+        spotify.player.off(events.player_end_of_track, onEndOfTrack);
+        spotify.player.off(events.player_second_in_song, onSecondInSong);
     });
 
     socket.on(events.player_seek, function(second) {
@@ -30,7 +39,7 @@ function Player(socket, spotify, events) {
     });
 
     socket.on(events.play, function(data) {
-        queue = playlists[data.playlistId].getTracks();
+        queue = playlistById(data.playlistId).getTracks().toArray();
         currentTrack = queue.filter( 
             function(track) { 
                 return track.id == data.trackId 
@@ -75,6 +84,17 @@ function Player(socket, spotify, events) {
 var playlists;
 var loggedIn = false;
 
+//playlist ids stay the same when playlists are added, moved or removed, they are no indices
+function playlistById(id) {
+    return playlists.filter(function(playlist) {
+        return playlist.id == id;
+    })[0];
+}
+
+spotify.on(events.playlist_container_changed, function() {
+    playlists = spotify.getPlaylists();
+}, {batch: true});
+
 
 io.sockets.on('connection', function(socket) {
     //variables per socket
@@ -91,14 +111,51 @@ io.sockets.on('connection', function(socket) {
         spotify.login(data.username, data.password, data.rememberMe, data.withRemembered);
     });
 
-    spotify.ready( function() {
+    //called after every login while the socket is connected
+    function onReady() {
         loggedIn = true;
         playlists = spotify.getPlaylists();
         sendInitialData();
-    });
+    }
+    spotify.ready(onReady, false);
 
-    spotify.playlists.on(events.playlist_renamed, function () {
+    function onPlaylistRenamed() {
         socket.emit(events.playlist_renamed, this);
+    }
+    spotify.playlists.on(events.playlist_renamed, onPlaylistRenamed);
+
+    //The client patches its tracks with the deltas, added tracks need their data so then all tracks are sent again
+    function onTracksChanged(err, deltas) {
+        var added = deltas.some(function(delta) { return delta.type === 'add'; });
+        if(added) {
+            sendTracks(displayedPlaylist);
+            return;
+        }
+        socket.emit(events.playlist_tracks_changed, {
+            id: displayedPlaylist.id,
+            deltas: deltas.map(function(delta) {
+                return {
+                    type: delta.type,
+                    position: delta.position,
+                    count: delta.count,
+                    indices: delta.indices && Array.prototype.slice.call(delta.indices),
+                    done: delta.done
+                };
+            })
+        });
+    }
+
+    //Sent as the JSON string of the native toJSON, the tracks already have their position as id
+    function sendTracks(playlist) {
+        socket.emit(events.playlist_tracks, playlist.toJSON(1));
+    }
+
+    socket.on('disconnect', function() {
+        spotify.offReady(onReady);
+        spotify.playlists.off(events.playlist_renamed, onPlaylistRenamed);
+        if(displayedPlaylist) {
+            displayedPlaylist.off(events.playlist_tracks_changed, onTracksChanged);
+        }
     });
 
     //Client wants to logout
@@ -107,34 +164,20 @@ io.sockets.on('connection', function(socket) {
     });
 
     socket.on(events.playlist_tracks, function(data) {
-        function generateTrackIds(tracks) {
-            for(var i=0;i<tracks.length;i++) {
-                tracks[i].id = i;
-            }
-        }
-
-        function loadAttachAndSendTracks(playlist) {
-            playlist.tracks = playlist.getTracks();
-            generateTrackIds(playlist.tracks);
-            socket.emit(events.playlist_tracks, playlist);
-        }
-
         if(displayedPlaylist) {
-            displayedPlaylist.off(events.playlist_tracks_changed);
+            displayedPlaylist.off(events.playlist_tracks_changed, onTracksChanged);
         }
 
-        displayedPlaylist = playlists[data.id];
-        //If tracks change for the currently displayed playlist, update them
-        displayedPlaylist.on(events.playlist_tracks_changed, function() {
-            loadAttachAndSendTracks(displayedPlaylist);
-        });
+        displayedPlaylist = playlistById(data.id);
+        //If tracks change for the currently displayed playlist, update them once for all changes of a tick
+        displayedPlaylist.on(events.playlist_tracks_changed, onTracksChanged, {batch: true});
 
-        loadAttachAndSendTracks(displayedPlaylist);
+        sendTracks(displayedPlaylist);
         //socket.emit(events.playlist_image, displayedPlaylist.getImageBase64());
     });
 
     socket.on(events.track_set_starred, function(data){
-        playlists[data.playlistId].getTracks()[data.trackId].starred = data.starred;
+        playlistById(data.playlistId).getTracks()[data.trackId].starred = data.starred;
     });
 
     //Client requests initial data
@@ -4,22 +4,29 @@
     "target_name": "nodespotify",
     "sources": [
       "src/node-spotify.cc", "src/audio/audio.c",
-      "src/callbacks/PlaylistCallbacks.cc",
+      "src/callbacks/PlaylistCallbacks.cc", "src/callbacks/PlaylistContainerCallbacks.cc",
       "src/callbacks/SessionCallbacks.cc",
       "src/callbacks/SearchCallbacks.cc", "src/callbacks/AlbumBrowseCallbacks.cc",
       "src/callbacks/ArtistBrowseCallbacks.cc",
 
-      "src/utils/ImageUtils.cc",
+      "src/utils/ImageUtils.cc", "src/utils/PromiseUtils.cc",
+      "src/utils/RequestUtils.cc",
+      "src/utils/Symbols.cc", "src/utils/TypedArrayUtils.cc",
+      "src/utils/JsonWriter.cc", "src/utils/JsonUtils.cc", "src/utils/MemoryUtils.cc",
+      "src/utils/PersistentUtils.cc",
 
       "src/objects/spotify/Track.cc", "src/objects/spotify/Artist.cc",
       "src/objects/spotify/Playlist.cc", "src/objects/spotify/PlaylistContainer.cc",
       "src/objects/spotify/Album.cc", "src/objects/spotify/Search.cc",
-      "src/objects/spotify/Spotify.cc",
+      "src/objects/spotify/Spotify.cc", "src/objects/spotify/RequestScheduler.cc",
+      "src/objects/spotify/JsonSerializer.cc", "src/objects/spotify/MetadataLoader.cc",
+      "src/objects/spotify/TrackSets.cc",
 
       "src/objects/node/NodeTrack.cc", "src/objects/node/NodeArtist.cc",
       "src/objects/node/NodePlaylist.cc", "src/objects/node/NodeAlbum.cc",
       "src/objects/node/NodePlayer.cc", "src/objects/node/NodeSearch.cc",
-      "src/objects/node/NodeSpotify.cc"
+      "src/objects/node/NodeSpotify.cc", "src/objects/node/EventBatch.cc",
+      "src/objects/node/NodePlaylistOps.cc"
     ],
     "link_settings" : {
       "libraries": ["-lspotify"]
@@ -9,9 +9,9 @@ fs.readFile('src/events.h', 'utf8', function(err, data) {
   var lines = data.split('\n');
   for(var i = 0; i < lines.length; i++) {
     var line = lines[i];
-    var tokens = line.split(' ');
-    if(tokens.length == 3) { //only if the line is in the format #define EVENT_NAME "event_name"
-      var event = tokens[1].toLowerCase();
+    var match = /EVENT\(\w+, "(\w+)"\)/.exec(line);
+    if(match) { //only if the line is in the format EVENT(EVENT_NAME, "event_name")
+      var event = match[1];
       events[event] = event;
     }
   }
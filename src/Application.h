@@ -29,6 +29,13 @@ THE SOFTWARE.
 #include <v8.h>
 #include <memory>
 #include "objects/spotify/PlaylistContainer.h"
+#include "objects/spotify/RequestScheduler.h"
+#include "objects/spotify/IdentityMap.h"
+#include "objects/spotify/MetadataLoader.h"
+#include "objects/spotify/Track.h"
+#include "objects/spotify/Album.h"
+#include "objects/spotify/Artist.h"
+#include "objects/spotify/Playlist.h"
 
 extern "C" {
   #include "audio/audio.h"
@@ -38,6 +45,13 @@ struct Application {
   sp_session* session;
   audio_fifo_t audio_fifo;
   std::shared_ptr<PlaylistContainer> playlistContainer;
+  RequestScheduler requestScheduler;
+  //One Track/Album/Artist/Playlist per libspotify object while it is in use
+  IdentityMap<sp_track, Track> tracks;
+  IdentityMap<sp_album, Album> albums;
+  IdentityMap<sp_artist, Artist> artists;
+  IdentityMap<sp_playlist, Playlist> playlists;
+  MetadataLoader metadataLoader;
 };
 
 #endif
\ No newline at end of file
@@ -25,10 +25,53 @@ THE SOFTWARE.
 #include "AlbumBrowseCallbacks.h"
 #include "../objects/spotify/Album.h"
 #include "../events.h"
+#include "../Application.h"
+
+#include <v8.h>
+
+extern Application* application;
 
 void AlbumBrowseCallbacks::albumBrowseComplete(sp_albumbrowse* result, void* userdata) {
   Album* album = static_cast<Album*>(userdata);
+  if(album->albumBrowse != result) {
+    //The browse timed out and was released already.
+    return;
+  }
+  application->requestScheduler.complete(album->browseRequest);
+  album->browseRequest = 0;
+  sp_error error = sp_albumbrowse_error(result);
+  if(error != SP_ERROR_OK) {
+    //Forget the failed browse so the next browse call tries again.
+    album->albumBrowse = nullptr;
+    sp_albumbrowse_release(result);
+  } else {
+    album->updateExternalMemory();
+  }
+  if(album->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    if(error == SP_ERROR_OK) {
+      album->nodeObject->call(ALBUMBROWSE_COMPLETE);
+    } else {
+      album->nodeObject->callError(ALBUMBROWSE_COMPLETE, sp_error_message(error));
+    }
+    scope.Close(v8::Undefined());
+  }
+  album->browsing.release();
+}
+
+/**
+ * Called by the request scheduler when the browse did not finish in time.
+ **/
+void AlbumBrowseCallbacks::albumBrowseTimeout(Album* album) {
+  album->browseRequest = 0;
+  if(album->albumBrowse != nullptr) {
+    sp_albumbrowse_release(album->albumBrowse);
+    album->albumBrowse = nullptr;
+  }
   if(album->nodeObject != nullptr) {
-    album->nodeObject->call(ALBUMBROWSE_COMPLETE);
+    v8::HandleScope scope;
+    album->nodeObject->callError(ALBUMBROWSE_COMPLETE, "Album browse timed out");
+    scope.Close(v8::Undefined());
   }
+  album->browsing.release();
 }
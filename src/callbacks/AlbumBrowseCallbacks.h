@@ -27,9 +27,12 @@ THE SOFTWARE.
 
 #include <libspotify/api.h>
 
+class Album;
+
 class AlbumBrowseCallbacks {
 public:
   static void albumBrowseComplete(sp_albumbrowse* result, void* userdata);
+  static void albumBrowseTimeout(Album* album);
 };
 
 #endif
\ No newline at end of file
@@ -24,12 +24,55 @@ THE SOFTWARE.
 
 #include "ArtistBrowseCallbacks.h"
 #include "../events.h"
+#include "../Application.h"
 
 #include "../objects/spotify/Artist.h"
 
+#include <v8.h>
+
+extern Application* application;
+
 void ArtistBrowseCallbacks::artistBrowseComplete(sp_artistbrowse* result, void* userdata) {
   Artist* artist = static_cast<Artist*>(userdata);
+  if(artist->artistBrowse != result) {
+    //The browse timed out and was released already.
+    return;
+  }
+  application->requestScheduler.complete(artist->browseRequest);
+  artist->browseRequest = 0;
+  sp_error error = sp_artistbrowse_error(result);
+  if(error != SP_ERROR_OK) {
+    //Forget the failed browse so the next browse call tries again.
+    artist->artistBrowse = nullptr;
+    sp_artistbrowse_release(result);
+  } else {
+    artist->updateExternalMemory();
+  }
+  if(artist->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    if(error == SP_ERROR_OK) {
+      artist->nodeObject->call(ARTISTBROWSE_COMPLETE);
+    } else {
+      artist->nodeObject->callError(ARTISTBROWSE_COMPLETE, sp_error_message(error));
+    }
+    scope.Close(v8::Undefined());
+  }
+  artist->browsing.release();
+}
+
+/**
+ * Called by the request scheduler when the browse did not finish in time.
+ **/
+void ArtistBrowseCallbacks::artistBrowseTimeout(Artist* artist) {
+  artist->browseRequest = 0;
+  if(artist->artistBrowse != nullptr) {
+    sp_artistbrowse_release(artist->artistBrowse);
+    artist->artistBrowse = nullptr;
+  }
   if(artist->nodeObject != nullptr) {
-    artist->nodeObject->call(ARTISTBROWSE_COMPLETE);
+    v8::HandleScope scope;
+    artist->nodeObject->callError(ARTISTBROWSE_COMPLETE, "Artist browse timed out");
+    scope.Close(v8::Undefined());
   }
-}
\ No newline at end of file
+  artist->browsing.release();
+}
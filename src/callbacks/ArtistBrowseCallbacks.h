@@ -27,9 +27,12 @@ THE SOFTWARE.
 
 #include <libspotify/api.h>
 
+class Artist;
+
 class ArtistBrowseCallbacks {
 public:
   static void artistBrowseComplete(sp_artistbrowse* result, void* userdata);
+  static void artistBrowseTimeout(Artist* artist);
 };
 
 #endif
\ No newline at end of file
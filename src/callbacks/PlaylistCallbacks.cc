@@ -25,58 +25,122 @@ THE SOFTWARE.
 #include "PlaylistCallbacks.h"
 #include "../objects/spotify/Track.h"
 #include "../objects/node/NodeTrack.h"
+#include "../objects/node/NodePlaylist.h"
 #include "../objects/spotify/Playlist.h"
+#include "SessionCallbacks.h"
 #include "../events.h"
+#include "../Application.h"
+#include "../utils/Symbols.h"
+#include "../utils/TypedArrayUtils.h"
 
 #include <v8.h>
 #include <memory>
+#include <vector>
+#include <algorithm>
+
+extern Application* application;
 
 void PlaylistCallbacks::playlistNameChange(sp_playlist* _playlist, void* userdata) {
   Playlist* playlist = static_cast<Playlist*>(userdata);
+  playlist->snapshot.reset();
   if(playlist->nodeObject != nullptr) {
     playlist->nodeObject->call(PLAYLIST_RENAMED);
   }
 }
 
 void PlaylistCallbacks::playlistStateChanged(sp_playlist* _playlist, void* userdata) {
+  Playlist* playlist = static_cast<Playlist*>(userdata);
+  playlist->checkSynced();
+  SessionCallbacks::checkPlaylistsLoaded();
+  application->metadataLoader.check();
+}
 
+/**
+ * The payload of playlist_tracks_changed, clients patch their copy of the tracks with it instead of reading all tracks again.
+ **/
+v8::Handle<v8::Object> PlaylistCallbacks::trackDelta(Playlist* playlist, v8::Handle<v8::String> type, int position, int count) {
+  v8::Local<v8::Object> delta = v8::Object::New();
+  delta->Set(Symbols::playlist, static_cast<NodePlaylist*>(playlist->nodeObject)->getV8Object());
+  delta->Set(Symbols::type, type);
+  delta->Set(Symbols::position, v8::Integer::New(position));
+  delta->Set(Symbols::count, v8::Integer::New(count));
+  return delta;
 }
 
 void PlaylistCallbacks::tracksAdded(sp_playlist* spPlaylist, sp_track *const *tracks, int num_tracks, int position, void *userdata) {
   Playlist* playlist  = static_cast<Playlist*>(userdata);
+  playlist->tracksAdded(tracks, num_tracks, position);
   if(playlist->nodeObject != nullptr) {
     v8::HandleScope scope;
     v8::Handle<v8::Array> nodeTracks = v8::Array::New(num_tracks);
     for(int i = 0; i < num_tracks; i++) {
-      NodeTrack* nodeTrack = new NodeTrack(std::make_shared<Track>(tracks[i]));
-      nodeTracks->Set(v8::Number::New(i), nodeTrack->getV8Object());
+      nodeTracks->Set(v8::Number::New(i), NodeTrack::fromTrack(application->tracks.get(tracks[i])));
     }
     playlist->nodeObject->call(PLAYLIST_TRACKS_ADDED, nodeTracks);
+    playlist->nodeObject->call(PLAYLIST_TRACKS_CHANGED, trackDelta(playlist, Symbols::add, position, num_tracks));
     scope.Close(Undefined());
   }
 }
 
-/*void PlaylistCallbacks::tracks_moved(sp_playlist* playlist, const int *tracks, int num_tracks, int new_position, void *userdata) {
-
-}*/
-
-/*void PlaylistCallbacks::tracks_removed(sp_playlist* spPlaylist, const int *tracks, int num_tracks, void *userdata) {
+/**
+ * Sends one delta per run of consecutive removed tracks, the last run first so the positions stay valid while they are applied.
+ **/
+void PlaylistCallbacks::tracksRemoved(sp_playlist* spPlaylist, const int *tracks, int num_tracks, void *userdata) {
   Playlist* playlist  = static_cast<Playlist*>(userdata);
-  if(playlist->tracksLoaded) {
-    pthread_mutex_lock(&playlist->lockingMutex);
-    auto it = playlist->tracks.begin();
-    for(int i = 0; i < num_tracks; i++) {
-      playlist->tracks.erase(it + tracks[i]);
+  playlist->tracksRemoved(tracks, num_tracks);
+  if(playlist->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    std::vector<int> sorted(tracks, tracks + num_tracks);
+    std::sort(sorted.begin(), sorted.end());
+    int end = sorted.size();
+    while(end > 0) {
+      int start = end - 1;
+      while(start > 0 && sorted[start - 1] >= sorted[start] - 1) {
+        start--;
+      }
+      int count = sorted[end - 1] - sorted[start] + 1;
+      playlist->nodeObject->call(PLAYLIST_TRACKS_CHANGED, trackDelta(playlist, Symbols::remove, sorted[start], count));
+      end = start;
     }
-    pthread_mutex_unlock(&playlist->lockingMutex);
-    playlist->call(PLAYLIST_TRACKS_CHANGED);
+    scope.Close(Undefined());
   }
-}*/
+}
 
-/*void playlist_update_in_progress(sp_playlist *pl, bool done, void *userdata) {
-  std::cout << "Update in progress" << std::endl;
+/**
+ * The delta has the old positions of the moved tracks in indices (ascending), position is where the first of them
+ * is after the move, i.e. take the tracks out and insert them at position.
+ **/
+void PlaylistCallbacks::tracksMoved(sp_playlist* spPlaylist, const int *tracks, int num_tracks, int new_position, void *userdata) {
+  Playlist* playlist  = static_cast<Playlist*>(userdata);
+  int position = playlist->tracksMoved(tracks, num_tracks, new_position);
+  if(playlist->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    std::vector<uint32_t> indices(tracks, tracks + num_tracks);
+    std::sort(indices.begin(), indices.end());
+    v8::Handle<v8::Object> delta = trackDelta(playlist, Symbols::move, position, num_tracks);
+    delta->Set(Symbols::indices, TypedArrayUtils::fromVector(indices));
+    playlist->nodeObject->call(PLAYLIST_TRACKS_CHANGED, delta);
+    scope.Close(Undefined());
+  }
+}
+
+/**
+ * libspotify changes many tracks at once, e.g. when a collaborative playlist syncs. Clients can wait for done to redraw.
+ **/
+void PlaylistCallbacks::playlistUpdateInProgress(sp_playlist* spPlaylist, bool done, void *userdata) {
+  Playlist* playlist  = static_cast<Playlist*>(userdata);
+  if(done) {
+    playlist->checkSynced();
+  }
+  if(playlist->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    v8::Handle<v8::Object> delta = trackDelta(playlist, Symbols::update, 0, 0);
+    delta->Set(Symbols::done, v8::Boolean::New(done));
+    playlist->nodeObject->call(PLAYLIST_TRACKS_CHANGED, delta);
+    scope.Close(Undefined());
+  }
 }
 
-void track_created_changed(sp_playlist *pl, int position, sp_user *user, int when, void *userdata) {
+/*void track_created_changed(sp_playlist *pl, int position, sp_user *user, int when, void *userdata) {
   std::cout << "Track created change" << std::endl;
 }*/
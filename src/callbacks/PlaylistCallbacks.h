@@ -27,16 +27,21 @@ THE SOFTWARE.
 
 #include <libspotify/api.h>
 #include <uv.h>
+#include <v8.h>
+
+class Playlist;
 
 class PlaylistCallbacks {
 public:
   static void playlistStateChanged(sp_playlist* _playlist, void* userdata);
   static void playlistNameChange(sp_playlist* spPlaylist, void* userdata);
   static void tracksAdded(sp_playlist* playlist, sp_track *const *tracks, int num_tracks, int position, void *userdata);
-  static void tracks_moved(sp_playlist* playlist, const int *tracks, int num_tracks, int new_position, void *userdata);
-  static void tracks_removed(sp_playlist* spPlaylist, const int *tracks, int num_tracks, void *userdata);
-  /* staticvoid playlist_update_in_progress(sp_playlist *pl, bool done, void *userdata);
-  static void track_created_changed(sp_playlist *pl, int position, sp_user *user, int when, void *userdata);*/
+  static void tracksMoved(sp_playlist* playlist, const int *tracks, int num_tracks, int new_position, void *userdata);
+  static void tracksRemoved(sp_playlist* spPlaylist, const int *tracks, int num_tracks, void *userdata);
+  static void playlistUpdateInProgress(sp_playlist* spPlaylist, bool done, void *userdata);
+  /*static void track_created_changed(sp_playlist *pl, int position, sp_user *user, int when, void *userdata);*/
+private:
+  static v8::Handle<v8::Object> trackDelta(Playlist* playlist, v8::Handle<v8::String> type, int position, int count);
 };
 
 #endif
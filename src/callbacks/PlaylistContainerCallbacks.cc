@@ -0,0 +1,90 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "PlaylistContainerCallbacks.h"
+#include "../objects/spotify/PlaylistContainer.h"
+#include "../objects/spotify/Spotify.h"
+#include "../objects/node/NodePlaylist.h"
+#include "../Application.h"
+#include "../events.h"
+#include "../utils/Symbols.h"
+
+extern Application* application;
+
+/**
+ * libspotify calls playlist_added for every entry while the container loads. Until container_loaded they are ignored,
+ * loadPlaylists reads all entries at once then and the playlists get their wrappers only when Javascript asks for them.
+ **/
+void PlaylistContainerCallbacks::playlistAdded(sp_playlistcontainer* pc, sp_playlist* playlist, int position, void* userdata) {
+  PlaylistContainer* playlistContainer = static_cast<PlaylistContainer*>(userdata);
+  if(!playlistContainer->isLoaded()) {
+    return;
+  }
+  const ContainerItem& item = playlistContainer->playlistAdded(position);
+  sendDelta(Symbols::add, item, position, position);
+}
+
+void PlaylistContainerCallbacks::playlistRemoved(sp_playlistcontainer* pc, sp_playlist* playlist, int position, void* userdata) {
+  PlaylistContainer* playlistContainer = static_cast<PlaylistContainer*>(userdata);
+  if(!playlistContainer->isLoaded()) {
+    return;
+  }
+  ContainerItem item = playlistContainer->playlistRemoved(position);
+  sendDelta(Symbols::remove, item, position, position);
+}
+
+void PlaylistContainerCallbacks::playlistMoved(sp_playlistcontainer* pc, sp_playlist* playlist, int position, int newPosition, void* userdata) {
+  PlaylistContainer* playlistContainer = static_cast<PlaylistContainer*>(userdata);
+  if(!playlistContainer->isLoaded()) {
+    return;
+  }
+  int movedTo = playlistContainer->playlistMoved(position, newPosition);
+  if(movedTo != -1) {
+    sendDelta(Symbols::move, playlistContainer->getItems()[movedTo], position, movedTo);
+  }
+}
+
+/**
+ * The payload is {type, id, position, newPosition} with the positions in the container (folder starts and ends count as entries),
+ * and playlist for playlists or folder (the name) for the start of a folder.
+ **/
+void PlaylistContainerCallbacks::sendDelta(v8::Handle<v8::String> type, const ContainerItem& item, int position, int newPosition) {
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(application->session));
+  if(spotify->nodeObject == nullptr) {
+    return;
+  }
+  v8::HandleScope scope;
+  v8::Local<v8::Object> delta = v8::Object::New();
+  delta->Set(Symbols::type, type);
+  delta->Set(Symbols::id, v8::Integer::New(item.id));
+  delta->Set(Symbols::position, v8::Integer::New(position));
+  delta->Set(Symbols::newPosition, v8::Integer::New(newPosition));
+  if(item.playlist) {
+    delta->Set(Symbols::playlist, NodePlaylist::fromPlaylist(item.playlist));
+  } else if(item.type == SP_PLAYLIST_TYPE_START_FOLDER) {
+    delta->Set(Symbols::folder, v8::String::New(item.folderName.c_str()));
+  }
+  spotify->nodeObject->call(PLAYLIST_CONTAINER_CHANGED, delta);
+  scope.Close(v8::Undefined());
+}
@@ -25,9 +25,48 @@ THE SOFTWARE.
 #include "SearchCallbacks.h"
 
 #include "../events.h"
+#include "../Application.h"
 #include "../objects/spotify/Search.h"
 
+#include <v8.h>
+
+extern Application* application;
+
 void SearchCallbacks::searchComplete(sp_search* spSearch, void* userdata) {
   Search* search = static_cast<Search*>(userdata);
-  search->nodeObject->call(SEARCH_COMPLETE);
-}
\ No newline at end of file
+  if(search->search != spSearch) {
+    //The search timed out and was released already.
+    return;
+  }
+  application->requestScheduler.complete(search->request);
+  search->request = 0;
+  search->updateExternalMemory();
+  if(search->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    sp_error error = sp_search_error(spSearch);
+    if(error == SP_ERROR_OK) {
+      search->nodeObject->call(SEARCH_COMPLETE);
+    } else {
+      search->nodeObject->callError(SEARCH_COMPLETE, sp_error_message(error));
+    }
+    scope.Close(v8::Undefined());
+  }
+  search->searching.release();
+}
+
+/**
+ * Called by the request scheduler when the search did not finish in time.
+ **/
+void SearchCallbacks::searchTimeout(Search* search) {
+  search->request = 0;
+  if(search->search != nullptr) {
+    sp_search_release(search->search);
+    search->search = nullptr;
+  }
+  if(search->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    search->nodeObject->callError(SEARCH_COMPLETE, "Search timed out");
+    scope.Close(v8::Undefined());
+  }
+  search->searching.release();
+}
@@ -27,9 +27,12 @@ THE SOFTWARE.
 
 #include <libspotify/api.h>
 
+class Search;
+
 class SearchCallbacks {
 public:
   static void searchComplete(sp_search* spSearch, void* userdata);
+  static void searchTimeout(Search* search);
 };
 
 #endif
\ No newline at end of file
@@ -27,8 +27,12 @@ THE SOFTWARE.
 #include "../Application.h"
 
 #include "../objects/spotify/PlaylistContainer.h"
+#include "../objects/spotify/Spotify.h"
 #include "../objects/node/NodePlayer.h"
+#include "../objects/node/NodeSpotify.h"
+#include "../objects/node/EventBatch.h"
 #include "../events.h"
+#include "../utils/PersistentUtils.h"
 
 extern "C" {
   #include "../audio/audio.h"
@@ -40,11 +44,16 @@ extern "C" {
 
 extern Application* application;
 
-static sp_playlistcontainer_callbacks rootPlaylistContainerCallbacks;
+static const int offlineStatusInterval = 1000;
 
 std::unique_ptr<uv_timer_t> SessionCallbacks::timer;
 std::unique_ptr<uv_async_t> SessionCallbacks::notifyHandle;
-v8::Handle<v8::Function> SessionCallbacks::loginCallback;
+std::unique_ptr<uv_timer_t> SessionCallbacks::offlineStatusTimer;
+uint64_t SessionCallbacks::lastOfflineStatusUpdate = 0;
+std::vector<v8::Persistent<v8::Function>> SessionCallbacks::readyCallbacks;
+std::vector<v8::Persistent<v8::Function>> SessionCallbacks::readyOnceCallbacks;
+std::vector<v8::Persistent<v8::Function>> SessionCallbacks::readyDeferredCallbacks;
+std::unique_ptr<uv_async_t> SessionCallbacks::readyHandle;
 
 namespace spotify {
 //TODO
@@ -55,8 +64,12 @@ int currentSecond = 0;
 void SessionCallbacks::init() {
   timer = std::unique_ptr<uv_timer_t>(new uv_timer_t());
   notifyHandle = std::unique_ptr<uv_async_t>(new uv_async_t());
+  offlineStatusTimer = std::unique_ptr<uv_timer_t>(new uv_timer_t());
+  readyHandle = std::unique_ptr<uv_async_t>(new uv_async_t());
   uv_async_init(uv_default_loop(), notifyHandle.get(), handleNotify);
+  uv_async_init(uv_default_loop(), readyHandle.get(), callDeferredReadyCallbacks);
   uv_timer_init(uv_default_loop(), timer.get());
+  uv_timer_init(uv_default_loop(), offlineStatusTimer.get());
 }
 
 /**
@@ -81,25 +94,36 @@ void SessionCallbacks::notifyMainThread(sp_session* session) {
 void SessionCallbacks::handleNotify(uv_async_t* handle, int status) {
   uv_timer_stop(timer.get()); //a new timeout will be set at the end
   int nextTimeout = 0;
+  EventBatch::begin();
   while(nextTimeout == 0) {
     sp_session_process_events(application->session, &nextTimeout);
   }
+  EventBatch::flush();
   uv_timer_start(timer.get(), &processEvents, nextTimeout, 0);
 }
 
 void SessionCallbacks::loggedIn(sp_session* session, sp_error error) {
   if(SP_ERROR_OK != error) {
     std::cout << "Error logging in: " << sp_error_message(error) << std::endl;
+    failReadyCallbacks(error);
     return;
   } else {
     std::cout << "Logged in" << std::endl;
   }
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(session));
+  spotify->timeToReady.loggedIn = uv_hrtime();
 
   //The creation of the root playlist container is absolutely necessary here, otherwise following callbacks can crash.
-  rootPlaylistContainerCallbacks.container_loaded = &SessionCallbacks::rootPlaylistContainerLoaded;
   sp_playlistcontainer *pc = sp_session_playlistcontainer(application->session);
+  if(application->playlistContainer && application->playlistContainer->playlistContainer == pc) {
+    //Logged in again without a logout, the container and its playlists are kept and only read again if it is loaded already
+    if(sp_playlistcontainer_is_loaded(pc)) {
+      rootPlaylistContainerLoaded(pc, application->playlistContainer.get());
+    }
+    return;
+  }
   application->playlistContainer = std::make_shared<PlaylistContainer>(pc);
-  sp_playlistcontainer_add_callbacks(pc, &rootPlaylistContainerCallbacks, application->playlistContainer.get());
+  application->playlistContainer->addCallbacks();
 }
 
 void SessionCallbacks::loggedOut(sp_session* session) {
@@ -108,13 +132,170 @@ void SessionCallbacks::loggedOut(sp_session* session) {
 
 void SessionCallbacks::rootPlaylistContainerLoaded(sp_playlistcontainer* spPlaylistContainer, void* userdata) {
   PlaylistContainer* playlistContainer = static_cast<PlaylistContainer*>(userdata);
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(application->session));
+  if(spotify->timeToReady.playlistContainerLoaded != 0) {
+    //already handled for this login
+    return;
+  }
+  spotify->timeToReady.playlistContainerLoaded = uv_hrtime();
   playlistContainer->loadPlaylists();
+  checkPlaylistsLoaded();
+
+  //Trigger the login complete callbacks
+  v8::HandleScope scope;
+  std::vector<v8::Persistent<v8::Function>> onceCallbacks;
+  onceCallbacks.swap(readyOnceCallbacks);
+  //the callbacks can add or remove ready callbacks, so go over local handles of them
+  std::vector<v8::Local<v8::Function>> callbacks;
+  for(auto it = readyCallbacks.begin(); it != readyCallbacks.end(); it++) {
+    callbacks.push_back(v8::Local<v8::Function>::New(*it));
+  }
+  for(auto it = callbacks.begin(); it != callbacks.end(); it++) {
+    (*it)->Call(v8::Context::GetCurrent()->Global(), 0, NULL);
+  }
+  for(auto it = onceCallbacks.begin(); it != onceCallbacks.end(); it++) {
+    (*it)->Call(v8::Context::GetCurrent()->Global(), 0, NULL);
+    PersistentUtils::dispose(*it);
+  }
+  scope.Close(v8::Undefined());
+}
+
+/**
+ * The session is ready when the user is logged in and the playlist container is loaded.
+ **/
+bool SessionCallbacks::isReady() {
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(application->session));
+  return application->playlistContainer && spotify->timeToReady.playlistContainerLoaded != 0;
+}
+
+/**
+ * Adds a callback for when the session is ready. Callbacks that are not once are called after every login.
+ * If the session is already ready the callback is called on the next turn of the event loop, never from within ready().
+ * Adding the same callback again, e.g. on every reconnect, does not register it twice.
+ **/
+void SessionCallbacks::addReadyCallback(v8::Handle<v8::Function> callback, bool once) {
+  if(isReady()) {
+    readyDeferredCallbacks.push_back(PersistentUtils::create(callback));
+    uv_async_send(readyHandle.get());
+    if(once) {
+      return;
+    }
+  }
+  std::vector<v8::Persistent<v8::Function>>& callbacks = once ? readyOnceCallbacks : readyCallbacks;
+  for(auto it = callbacks.begin(); it != callbacks.end(); it++) {
+    if((*it)->StrictEquals(callback)) {
+      return;
+    }
+  }
+  callbacks.push_back(PersistentUtils::create(callback));
+}
+
+/**
+ * Removes the callback from all ready callbacks, including a pending deferred call. Returns how many were removed.
+ **/
+int SessionCallbacks::removeReadyCallback(v8::Handle<v8::Function> callback) {
+  int removed = 0;
+  std::vector<v8::Persistent<v8::Function>>* lists[] = {&readyCallbacks, &readyOnceCallbacks, &readyDeferredCallbacks};
+  for(auto callbacks : lists) {
+    for(auto it = callbacks->begin(); it != callbacks->end();) {
+      if((*it)->StrictEquals(callback)) {
+        PersistentUtils::dispose(*it);
+        it = callbacks->erase(it);
+        removed++;
+      } else {
+        it++;
+      }
+    }
+  }
+  return removed;
+}
+
+/**
+ * Calls the once callbacks, promises and deferred calls of ready() with the login error. They are removed,
+ * callbacks added with once set to false stay for the next login.
+ **/
+void SessionCallbacks::failReadyCallbacks(sp_error error) {
+  v8::HandleScope scope;
+  std::vector<v8::Persistent<v8::Function>> callbacks;
+  callbacks.swap(readyOnceCallbacks);
+  callbacks.insert(callbacks.end(), readyDeferredCallbacks.begin(), readyDeferredCallbacks.end());
+  readyDeferredCallbacks.clear();
+  v8::Handle<v8::Value> argv[1] = {v8::Exception::Error(v8::String::New(sp_error_message(error)))};
+  for(auto it = callbacks.begin(); it != callbacks.end(); it++) {
+    (*it)->Call(v8::Context::GetCurrent()->Global(), 1, argv);
+    PersistentUtils::dispose(*it);
+  }
+  scope.Close(v8::Undefined());
+}
+
+/**
+ * Calls the callbacks added with ready() while the session already was ready.
+ **/
+void SessionCallbacks::callDeferredReadyCallbacks(uv_async_t* handle, int status) {
+  v8::HandleScope scope;
+  std::vector<v8::Persistent<v8::Function>> callbacks;
+  callbacks.swap(readyDeferredCallbacks);
+  for(auto it = callbacks.begin(); it != callbacks.end(); it++) {
+    (*it)->Call(v8::Context::GetCurrent()->Global(), 0, NULL);
+    PersistentUtils::dispose(*it);
+  }
+  scope.Close(v8::Undefined());
+}
+
+/**
+ * libspotify does not say which objects got their metadata, so all pending loads are checked.
+ **/
+void SessionCallbacks::metadataUpdated(sp_session* session) {
+  application->metadataLoader.check();
+}
+
+/**
+ * Records the time when all playlists of the root container are loaded for the first time after a login.
+ **/
+void SessionCallbacks::checkPlaylistsLoaded() {
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(application->session));
+  if(spotify->timeToReady.playlistsLoaded == 0 && application->playlistContainer && application->playlistContainer->allPlaylistsLoaded()) {
+    spotify->timeToReady.playlistsLoaded = uv_hrtime();
+  }
+}
+
+/**
+ * Called by libspotify when a new credentials blob is available. The blob can be stored and used
+ * to login again with loginWithCredentialsBlob without the password.
+ **/
+void SessionCallbacks::credentialsBlobUpdated(sp_session* session, const char* blob) {
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(session));
+  if(spotify->nodeObject != nullptr) {
+    v8::HandleScope scope;
+    spotify->nodeObject->call(CREDENTIALS_BLOB_UPDATED, v8::String::New(blob));
+    scope.Close(v8::Undefined());
+  }
+}
+
+/**
+ * libspotify calls this very often while syncing. The event is sent to Javascript at most
+ * once per offlineStatusInterval milliseconds, the last update in an interval is always delivered.
+ **/
+void SessionCallbacks::offlineStatusUpdated(sp_session* session) {
+  uint64_t now = uv_now(uv_default_loop());
+  uint64_t elapsed = now - lastOfflineStatusUpdate;
+  if(elapsed >= (uint64_t)offlineStatusInterval) {
+    uv_timer_stop(offlineStatusTimer.get());
+    sendOfflineStatus(offlineStatusTimer.get(), 0);
+  } else {
+    //the deadline stays lastOfflineStatusUpdate + offlineStatusInterval even if the timer is restarted
+    uv_timer_start(offlineStatusTimer.get(), &sendOfflineStatus, offlineStatusInterval - elapsed, 0);
+  }
+}
 
-  //Trigger the login complete callback
-  if(!loginCallback.IsEmpty()) {
-    unsigned int argc = 0;
-    v8::Handle<v8::Value> argv[0];
-    loginCallback->Call(v8::Context::GetCurrent()->Global(), argc, argv);
+void SessionCallbacks::sendOfflineStatus(uv_timer_t* timer, int status) {
+  lastOfflineStatusUpdate = uv_now(uv_default_loop());
+  Spotify* spotify = static_cast<Spotify*>(sp_session_userdata(application->session));
+  if(spotify->nodeObject != nullptr && application->playlistContainer) {
+    v8::HandleScope scope;
+    OfflineSyncStatus syncStatus = application->playlistContainer->offlineSyncStatus();
+    spotify->nodeObject->call(OFFLINE_STATUS_UPDATED, NodeSpotify::offlineSyncStatusToObject(syncStatus));
+    scope.Close(v8::Undefined());
   }
 }
 
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <libspotify/api.h>
 #include <uv.h>
 #include <memory>
+#include <vector>
 #include <v8.h>
 
 class SessionCallbacks {
@@ -38,13 +39,28 @@ public:
   static void rootPlaylistContainerLoaded(sp_playlistcontainer* spPlaylistContainer, void* userdata);
   static int music_delivery(sp_session *sess, const sp_audioformat *format, const void *frames, int num_frames);
   static void end_of_track(sp_session* session);
+  static void credentialsBlobUpdated(sp_session* session, const char* blob);
+  static void checkPlaylistsLoaded();
+  static void offlineStatusUpdated(sp_session* session);
+  static void metadataUpdated(sp_session* session);
   static void handleNotify(uv_async_t* handle, int status);
   static void init();
-  static v8::Handle<v8::Function> loginCallback;
+  static void addReadyCallback(v8::Handle<v8::Function> callback, bool once);
+  static int removeReadyCallback(v8::Handle<v8::Function> callback);
+  static bool isReady();
 private:
+  static std::vector<v8::Persistent<v8::Function>> readyCallbacks;
+  static std::vector<v8::Persistent<v8::Function>> readyOnceCallbacks;
+  static std::vector<v8::Persistent<v8::Function>> readyDeferredCallbacks;
+  static std::unique_ptr<uv_async_t> readyHandle;
+  static void callDeferredReadyCallbacks(uv_async_t* handle, int status);
+  static void failReadyCallbacks(sp_error error);
   static std::unique_ptr<uv_timer_t> timer;
   static std::unique_ptr<uv_async_t> notifyHandle;
+  static std::unique_ptr<uv_timer_t> offlineStatusTimer;
+  static uint64_t lastOfflineStatusUpdate;
   static void processEvents(uv_timer_t* timer, int status);
+  static void sendOfflineStatus(uv_timer_t* timer, int status);
 };
 
 #endif
@@ -24,11 +24,29 @@ THE SOFTWARE.
 
 #ifndef _EVENTS_H
 #define _EVENTS_H
-#define PLAYLIST_RENAMED "playlist_renamed"
-#define PLAYLIST_TRACKS_ADDED "playlist_tracks_added"
-#define PLAYER_SECOND_IN_SONG "player_second_in_song"
-#define PLAYER_END_OF_TRACK "player_end_of_track"
-#define SEARCH_COMPLETE "search_complete"
-#define ALBUMBROWSE_COMPLETE "albumbrowse_complete"
-#define ARTISTBROWSE_COMPLETE "artistbrowse_complete"
-#endif
\ No newline at end of file
+
+/**
+ * All events that can be listened to with on(name, callback). Callbacks are stored in arrays indexed by the event id.
+ * preprocessor.js reads the EVENT lines to write events.js.
+ **/
+#define EVENTS(EVENT) \
+  EVENT(PLAYLIST_RENAMED, "playlist_renamed") \
+  EVENT(PLAYLIST_TRACKS_ADDED, "playlist_tracks_added") \
+  EVENT(PLAYLIST_TRACKS_CHANGED, "playlist_tracks_changed") \
+  EVENT(PLAYER_SECOND_IN_SONG, "player_second_in_song") \
+  EVENT(PLAYER_END_OF_TRACK, "player_end_of_track") \
+  EVENT(SEARCH_COMPLETE, "search_complete") \
+  EVENT(ALBUMBROWSE_COMPLETE, "albumbrowse_complete") \
+  EVENT(ARTISTBROWSE_COMPLETE, "artistbrowse_complete") \
+  EVENT(CREDENTIALS_BLOB_UPDATED, "credentials_blob_updated") \
+  EVENT(PLAYLIST_CONTAINER_CHANGED, "playlist_container_changed") \
+  EVENT(OFFLINE_STATUS_UPDATED, "offline_status_updated")
+
+enum Event {
+#define EVENT_ID(id, name) id,
+  EVENTS(EVENT_ID)
+#undef EVENT_ID
+  EVENT_COUNT
+};
+
+#endif
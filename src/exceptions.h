@@ -26,7 +26,20 @@ THE SOFTWARE.
 #define _NODESPOTIFY_EXCEPTIONS_H
 
 #include <exception>
+#include <string>
 
 class FileException : public std::exception {};
 
+/**
+ * Thrown when an option given to node-spotify has an invalid value.
+ **/
+class OptionException : public std::exception {
+public:
+  OptionException(const std::string& _message) : message(_message) {};
+  ~OptionException() throw() {};
+  const char* what() const throw() { return message.c_str(); };
+private:
+  std::string message;
+};
+
 #endif
\ No newline at end of file
@@ -31,8 +31,11 @@ THE SOFTWARE.
 #include "objects/node/NodeAlbum.h"
 #include "objects/node/NodeArtist.h"
 #include "objects/node/NodeSearch.h"
+#include "objects/node/NodeList.h"
 #include "objects/node/StaticCallbackSetter.h"
+#include "objects/node/NodePlaylistOps.h"
 #include "audio/audio.h"
+#include "utils/Symbols.h"
 
 #include <node.h>
 #include <v8.h>
@@ -42,6 +45,7 @@ Application* application;
 v8::Handle<v8::Value> CreateNodespotify(const v8::Arguments& args) {
   v8::HandleScope scope;
 
+  Symbols::init();
   //initiate the javascript ctors and prototypes
   NodePlaylist::init();
   NodeTrack::init();
@@ -49,6 +53,10 @@ v8::Handle<v8::Value> CreateNodespotify(const v8::Arguments& args) {
   NodePlayer::init();
   NodeAlbum::init();
   NodeSearch::init();
+  NodeList<Track>::init("TrackList", &NodeTrack::fromTrack, &NodeTrack::initTrackList);
+  NodeList<Album>::init("AlbumList", &NodeAlbum::fromAlbum);
+  NodeList<Artist>::init("ArtistList", &NodeArtist::fromArtist);
+  NodeList<Playlist>::init("PlaylistList", &NodePlaylist::fromPlaylist);
   NodeSpotify::init();
 
   application = new Application();
@@ -69,11 +77,14 @@ v8::Handle<v8::Value> CreateNodespotify(const v8::Arguments& args) {
     nodeSpotify = new NodeSpotify(options);
   } catch (const FileException& e) {
     return scope.Close(ThrowException(Exception::Error(String::New("Appkey file not found"))));
+  } catch (const OptionException& e) {
+    return scope.Close(ThrowException(Exception::Error(String::New(e.what()))));
   }
   v8::Handle<Object> out = nodeSpotify->getV8Object();
   out->Set(v8::String::NewSymbol("Search"), NodeSearch::getConstructor());//TODO: this is ugly but didn't work when done in the NodeSpotify ctor
   out->Set(v8::String::NewSymbol("player"), NodePlayer::getInstance().getV8Object());
   StaticCallbackSetter<NodePlaylist>::init(out, "playlists");
+  NodePlaylistOps::init(out, "playlistOps");
   return scope.Close(out);
 };
 
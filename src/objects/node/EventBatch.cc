@@ -0,0 +1,123 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "EventBatch.h"
+#include "../../utils/PersistentUtils.h"
+
+bool EventBatch::active = false;
+std::vector<EventBatch::Entry> EventBatch::entries;
+std::map<std::pair<V8Callable*, int>, size_t> EventBatch::entryIndex;
+
+void EventBatch::begin() {
+  active = true;
+}
+
+bool EventBatch::isActive() {
+  return active;
+}
+
+void EventBatch::add(V8Callable* target, v8::Handle<v8::Object> object, Event event, v8::Handle<v8::Value> error, v8::Handle<v8::Value> value) {
+  std::pair<V8Callable*, int> key(target, event);
+  bool isError = !error->IsUndefined();
+  auto it = entryIndex.find(key);
+  if(it != entryIndex.end() && !isError) {
+    Entry& entry = entries[it->second];
+    if(!entry.values.back()->StrictEquals(value)) {
+      entry.values.push_back(PersistentUtils::create(value));
+    }
+    return;
+  }
+  Entry entry;
+  entry.target = target;
+  entry.event = event;
+  entry.object = PersistentUtils::create(object);
+  if(isError) {
+    entry.error = PersistentUtils::create(error);
+    //later events of the object must not be delivered before the error
+    entryIndex.erase(key);
+  } else {
+    entryIndex[key] = entries.size();
+  }
+  entry.values.push_back(PersistentUtils::create(value));
+  entries.push_back(entry);
+}
+
+void EventBatch::appendValues(v8::Handle<v8::Array> values, const Entry& entry) {
+  for(size_t i = 0; i < entry.values.size(); i++) {
+    values->Set(values->Length(), entry.values[i]);
+  }
+}
+
+void EventBatch::flush() {
+  active = false;
+  if(entries.empty()) {
+    return;
+  }
+  //Listeners may cause new events, they are called right away
+  std::vector<Entry> delivering;
+  delivering.swap(entries);
+  entryIndex.clear();
+
+  v8::HandleScope scope;
+  std::vector<bool> delivered(delivering.size(), false);
+  for(size_t i = 0; i < delivering.size(); i++) {
+    if(delivered[i]) {
+      continue;
+    }
+    Entry& entry = delivering[i];
+    Listeners* listeners = &entry.target->getListeners(entry.event);
+    bool isStatic = listeners->empty();
+    if(isStatic) {
+      listeners = &entry.target->getStaticListeners(entry.event);
+    }
+    if(!entry.error.IsEmpty()) {
+      listeners->call(entry.error, entry.values[0]);
+      continue;
+    }
+    v8::Handle<v8::Array> values = v8::Array::New();
+    appendValues(values, entry);
+    //other objects of the class without own listeners join the batch, up to their next error
+    for(size_t j = i + 1; isStatic && j < delivering.size(); j++) {
+      Entry& other = delivering[j];
+      if(delivered[j] || !other.target->getListeners(other.event).empty() || &other.target->getStaticListeners(other.event) != listeners) {
+        continue;
+      }
+      if(!other.error.IsEmpty()) {
+        break;
+      }
+      appendValues(values, other);
+      delivered[j] = true;
+    }
+    listeners->callBatch(v8::Undefined(), values);
+  }
+
+  for(auto it = delivering.begin(); it != delivering.end(); it++) {
+    PersistentUtils::dispose(it->object);
+    PersistentUtils::dispose(it->error);
+    for(size_t i = 0; i < it->values.size(); i++) {
+      PersistentUtils::dispose(it->values[i]);
+    }
+  }
+  scope.Close(v8::Undefined());
+}
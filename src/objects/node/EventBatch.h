@@ -0,0 +1,67 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _EVENT_BATCH_H
+#define _EVENT_BATCH_H
+
+#include <v8.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "V8Callable.h"
+#include "../../events.h"
+
+/**
+ * Collects the events that libspotify fires while its events are processed and delivers them afterwards,
+ * one call per listener with all payloads of an object and event, see Listeners::callBatch.
+ * A payload that is the same as the one before for the same object and event (e.g. many renames of a playlist) is dropped.
+ * Objects without own listeners are delivered to the static listeners of their class together.
+ * The batches are delivered in the order of their first event. An error is delivered on its own at its place,
+ * events of the same object and event after it start a new batch. Outside of begin/flush events are called right away.
+ **/
+class EventBatch {
+public:
+  static void begin();
+  static bool isActive();
+  static void add(V8Callable* target, v8::Handle<v8::Object> object, Event event, v8::Handle<v8::Value> error, v8::Handle<v8::Value> value);
+  static void flush();
+private:
+  struct Entry {
+    V8Callable* target;
+    Event event;
+    //Keeps the Javascript object and with it target alive until the entry is delivered
+    v8::Persistent<v8::Object> object;
+    //empty unless the entry is an error, then it has exactly one value
+    v8::Persistent<v8::Value> error;
+    std::vector<v8::Persistent<v8::Value>> values;
+  };
+  static void appendValues(v8::Handle<v8::Array> values, const Entry& entry);
+
+  static bool active;
+  static std::vector<Entry> entries;
+  static std::map<std::pair<V8Callable*, int>, size_t> entryIndex;
+};
+
+#endif
@@ -0,0 +1,187 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _LISTENERS_H
+#define _LISTENERS_H
+
+#include <v8.h>
+
+#include "../../utils/SmallVector.h"
+#include "../../utils/PersistentUtils.h"
+
+/**
+ * The Javascript functions listening for one event, in the order they were added.
+ * Most events have no or one listener so they are stored inline, calling all listeners is a loop over the list.
+ * Batch listeners get an array of all payloads of an event loop tick in one call, others are called once per payload.
+ **/
+class Listeners {
+public:
+  Listeners() : modifications(0) {}
+
+  ~Listeners() {
+    removeAll();
+  }
+
+  int size() const {
+    return listeners.size();
+  }
+
+  bool empty() const {
+    return listeners.empty();
+  }
+
+  void add(v8::Handle<v8::Function> function, bool once, bool batch = false) {
+    Listener listener;
+    listener.function = PersistentUtils::create(function);
+    listener.id = nextId();
+    listener.once = once;
+    listener.batch = batch;
+    listeners.push_back(listener);
+    modifications++;
+  }
+
+  /**
+   * Removes the listener that was added last with this function, like EventEmitter.removeListener.
+   * Returns the number of removed listeners.
+   **/
+  int remove(v8::Handle<v8::Value> function) {
+    for(int i = listeners.size() - 1; i >= 0; i--) {
+      if(listeners[i].function->StrictEquals(function)) {
+        PersistentUtils::dispose(listeners[i].function);
+        listeners.erase(i);
+        modifications++;
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  int removeAll() {
+    int removed = listeners.size();
+    for(int i = 0; i < removed; i++) {
+      PersistentUtils::dispose(listeners[i].function);
+    }
+    listeners.clear();
+    modifications++;
+    return removed;
+  }
+
+  /**
+   * Calls all listeners with one payload, batch listeners get it in an array.
+   **/
+  void call(v8::Handle<v8::Value> error, v8::Handle<v8::Value> value) {
+    forEach([&](Listener& listener) {
+      v8::Handle<v8::Value> argv[2] = {error, value};
+      if(listener.batch) {
+        v8::Handle<v8::Array> values = v8::Array::New(1);
+        values->Set(0, value);
+        argv[1] = values;
+      }
+      listener.function->Call(v8::Context::GetCurrent()->Global(), 2, argv);
+    });
+  }
+
+  /**
+   * Calls batch listeners once with all values, the others once per value (once listeners only with the first).
+   **/
+  void callBatch(v8::Handle<v8::Value> error, v8::Handle<v8::Array> values) {
+    int length = values->Length();
+    forEach([&](Listener& listener) {
+      v8::Handle<v8::Value> argv[2] = {error, values};
+      if(listener.batch) {
+        listener.function->Call(v8::Context::GetCurrent()->Global(), 2, argv);
+        return;
+      }
+      for(int i = 0; i < length && (i == 0 || !listener.once); i++) {
+        argv[1] = values->Get(i);
+        listener.function->Call(v8::Context::GetCurrent()->Global(), 2, argv);
+      }
+    });
+  }
+private:
+  struct Listener {
+    v8::Persistent<v8::Function> function;
+    unsigned int id;
+    bool once;
+    bool batch;
+  };
+
+  /**
+   * Runs callListener for all listeners in the order they were added. Once listeners are taken out before anything is called.
+   * Listeners can add and remove listeners while they are called, a listener that was removed by an earlier one is not called anymore.
+   **/
+  template <class F>
+  void forEach(F callListener) {
+    if(listeners.empty()) {
+      return;
+    }
+    SmallVector<Listener, 4> calling;
+    int kept = 0;
+    for(int i = 0; i < listeners.size(); i++) {
+      calling.push_back(listeners[i]);
+      if(!listeners[i].once) {
+        listeners[kept++] = listeners[i];
+      }
+    }
+    while(listeners.size() > kept) {
+      listeners.pop_back();
+    }
+    unsigned int unmodified = ++modifications;
+
+    for(int i = 0; i < calling.size(); i++) {
+      if(!calling[i].once && modifications != unmodified && !contains(calling[i].id)) {
+        continue;
+      }
+      callListener(calling[i]);
+    }
+
+    for(int i = 0; i < calling.size(); i++) {
+      if(calling[i].once) {
+        PersistentUtils::dispose(calling[i].function);
+      }
+    }
+  }
+
+  Listeners(const Listeners& other);
+  Listeners& operator=(const Listeners& other);
+
+  static unsigned int nextId() {
+    static unsigned int id = 0;
+    return ++id;
+  }
+
+  bool contains(unsigned int id) {
+    for(int i = 0; i < listeners.size(); i++) {
+      if(listeners[i].id == id) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  SmallVector<Listener, 1> listeners;
+  unsigned int modifications;
+};
+
+#endif
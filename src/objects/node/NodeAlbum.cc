@@ -24,9 +24,25 @@ THE SOFTWARE.
 
 #include "NodeAlbum.h"
 #include "NodeTrack.h"
+#include "NodeList.h"
 #include "NodeArtist.h"
 #include "../spotify/Track.h"
 #include "../../events.h"
+#include "../../utils/PromiseUtils.h"
+#include "../../utils/RequestUtils.h"
+#include "../../utils/JsonUtils.h"
+#include "../spotify/JsonSerializer.h"
+
+/**
+ * Returns the Javascript object of the album. While it is not garbage collected the same object is returned.
+ **/
+Handle<Object> NodeAlbum::fromAlbum(std::shared_ptr<Album> album) {
+  if(album->nodeObject != nullptr) {
+    return static_cast<NodeAlbum*>(album->nodeObject)->getV8Object();
+  }
+  NodeAlbum* nodeAlbum = new NodeAlbum(album);
+  return nodeAlbum->getV8Object();
+}
 
 Handle<Value> NodeAlbum::getName(Local<String> property, const AccessorInfo& info) {
   NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(info.Holder());
@@ -44,37 +60,38 @@ Handle<Value> NodeAlbum::getCoverBase64(const Arguments& args) {
   return scope.Close(String::New(nodeAlbum->album->coverBase64().c_str()));
 }
 
+/**
+ * Browse the album. All callers get called back, if a browse is already running no new one is started.
+ **/
 Handle<Value> NodeAlbum::browse(const Arguments& args) {
   HandleScope scope;
   NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(args.This());
-  if(nodeAlbum->album->albumBrowse == nullptr) {
-    Persistent<Function> callback = Persistent<Function>::New(Handle<Function>::Cast(args[0]));
-    nodeAlbum->on(ALBUMBROWSE_COMPLETE, callback);
-
-    //Mutate the V8 object.
-    Handle<Object> nodeAlbumV8 = nodeAlbum->getV8Object();
-    nodeAlbumV8->SetAccessor(String::NewSymbol("tracks"), getTracks);
-    nodeAlbumV8->SetAccessor(String::NewSymbol("review"), getReview);
-    nodeAlbumV8->SetAccessor(String::NewSymbol("copyrights"), getCopyrights);
-    nodeAlbumV8->SetAccessor(String::NewSymbol("artist"), getArtist);
-
-    nodeAlbum->album->browse();
-  } else {
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(args[0], callback);
+  if(!callback.IsEmpty()) {
+    nodeAlbum->once(ALBUMBROWSE_COMPLETE, callback);
+  }
+  if(nodeAlbum->album->albumBrowse == nullptr && nodeAlbum->album->browseRequest == 0) {
+    RequestOptions options = RequestUtils::parseOptions(RequestUtils::optionsArgument(args, 1));
+    nodeAlbum->album->browse(options.priority, options.timeout);
+  } else if(nodeAlbum->album->isBrowsed()) {
     nodeAlbum->call(ALBUMBROWSE_COMPLETE);
   }
-  return scope.Close(Undefined());
+  return scope.Close(promise);
+}
+
+/**
+ * The browse properties (tracks, review, copyrights, artist) are empty until browsed is true.
+ **/
+Handle<Value> NodeAlbum::getBrowsed(Local<String> property, const AccessorInfo& info) {
+  NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(info.Holder());
+  return Boolean::New(nodeAlbum->album->isBrowsed());
 }
 
 Handle<Value> NodeAlbum::getTracks(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(info.Holder());
-  std::vector<std::shared_ptr<Track>> tracks = nodeAlbum->album->tracks();
-  Handle<Array> nodeTracks = Array::New(tracks.size());
-  for(int i = 0; i < (int)tracks.size(); i++) {
-    NodeTrack* nodeTrack = new NodeTrack(tracks[i]);
-    nodeTracks->Set(Number::New(i), nodeTrack->getV8Object());
-  }
-  return scope.Close(nodeTracks);
+  return scope.Close(NodeList<Track>::fromVector(nodeAlbum->album->tracks()));
 }
 
 Handle<Value> NodeAlbum::getReview(Local<String> property, const AccessorInfo& info) {
@@ -98,8 +115,37 @@ Handle<Value> NodeAlbum::getCopyrights(Local<String> property, const AccessorInf
 Handle<Value> NodeAlbum::getArtist(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(info.Holder());
-  NodeArtist* nodeArtist = new NodeArtist(nodeAlbum->album->artist());
-  return scope.Close(nodeArtist->getV8Object());
+  std::shared_ptr<Artist> artist = nodeAlbum->album->artist();
+  if(!artist) {
+    return scope.Close(Undefined());
+  }
+  return scope.Close(NodeArtist::fromArtist(artist));
+}
+
+/**
+ * Releases the browse result now instead of waiting for the garbage collector.
+ * A pending browse is cancelled, its callbacks are called with an error.
+ **/
+Handle<Value> NodeAlbum::dispose(const Arguments& args) {
+  HandleScope scope;
+  NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(args.This());
+  bool pending = nodeAlbum->album->browseRequest != 0;
+  nodeAlbum->album->dispose();
+  if(pending) {
+    nodeAlbum->callError(ALBUMBROWSE_COMPLETE, "Album browse cancelled");
+  }
+  return scope.Close(Undefined());
+}
+
+/**
+ * Serializes the album natively, see JsonUtils::toJSON for the arguments.
+ **/
+Handle<Value> NodeAlbum::toJSON(const Arguments& args) {
+  NodeAlbum* nodeAlbum = node::ObjectWrap::Unwrap<NodeAlbum>(args.This());
+  std::shared_ptr<Album> album = nodeAlbum->album;
+  return JsonUtils::toJSON(args, [album](JsonWriter& writer, int depth, int trackFields) {
+    JsonSerializer::album(writer, *album, depth, trackFields);
+  });
 }
 
 void NodeAlbum::init() {
@@ -107,8 +153,15 @@ void NodeAlbum::init() {
   Handle<FunctionTemplate> constructorTemplate = NodeWrapped::init("Album");
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("name"), getName, emptySetter);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("link"), getLink, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("browsed"), getBrowsed, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("tracks"), getTracks, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("review"), getReview, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("copyrights"), getCopyrights, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("artist"), getArtist, emptySetter);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getCoverBase64", getCoverBase64);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "browse", browse);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "dispose", dispose);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "toJSON", toJSON);
   constructor = Persistent<Function>::New(constructorTemplate->GetFunction());
   scope.Close(Undefined());
 }
\ No newline at end of file
@@ -34,22 +34,35 @@ using namespace v8;
 
 class NodeAlbum : public NodeWrappedWithCallbacks<NodeAlbum> {
 friend class AlbumBrowseCallbacks;
+friend class NodeSpotify;
 private:
   std::shared_ptr<Album> album;
 public:
   NodeAlbum(std::shared_ptr<Album> _album) : album(_album) {
     album->nodeObject = this;
   };
+  /**
+   * Runs when the Javascript object was garbage collected. Nothing can read the browse result anymore,
+   * so it is released now instead of when the last C++ reference to the album is gone.
+   * A pending browse refs the object, so normally there is none here, it is never cancelled from the destructor.
+   **/
   ~NodeAlbum() {
     if(album->nodeObject == this) {
       album->nodeObject = nullptr;
+      if(album->browseRequest == 0) {
+        album->dispose();
+      }
     }
   }
+  static Handle<Object> fromAlbum(std::shared_ptr<Album> album);
+  static Handle<Value> toJSON(const Arguments& args);
   static void init();
   static Handle<Value> getName(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getLink(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getCoverBase64(const Arguments& args);
   static Handle<Value> browse(const Arguments& args);
+  static Handle<Value> dispose(const Arguments& args);
+  static Handle<Value> getBrowsed(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTracks(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getCopyrights(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getReview(Local<String> property, const AccessorInfo& info);
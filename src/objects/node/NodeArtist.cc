@@ -24,9 +24,25 @@ THE SOFTWARE.
 
 #include "NodeArtist.h"
 #include "NodeTrack.h"
+#include "NodeList.h"
 #include "NodeAlbum.h"
 
 #include "../../events.h"
+#include "../../utils/PromiseUtils.h"
+#include "../../utils/RequestUtils.h"
+#include "../../utils/JsonUtils.h"
+#include "../spotify/JsonSerializer.h"
+
+/**
+ * Returns the Javascript object of the artist. While it is not garbage collected the same object is returned.
+ **/
+Handle<Object> NodeArtist::fromArtist(std::shared_ptr<Artist> artist) {
+  if(artist->nodeObject != nullptr) {
+    return static_cast<NodeArtist*>(artist->nodeObject)->getV8Object();
+  }
+  NodeArtist* nodeArtist = new NodeArtist(artist);
+  return nodeArtist->getV8Object();
+}
 
 Handle<Value> NodeArtist::getName(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
@@ -40,76 +56,63 @@ Handle<Value> NodeArtist::getLink(Local<String> property, const AccessorInfo& in
   return scope.Close(String::New(nodeArtist->artist->link().c_str()));
 }
 
+/**
+ * Browse the artist. All callers get called back, if a browse is already running no new one is started.
+ * A browse is only reused if its type includes what is asked for, e.g. a FULL browse replaces a NO_TRACKS one.
+ **/
 Handle<Value> NodeArtist::browse(const Arguments& args) {
   HandleScope scope;
   NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(args.This());
-  if(nodeArtist->artist->artistBrowse == nullptr) {
-    sp_artistbrowse_type artistbrowseType = static_cast<sp_artistbrowse_type>(args[0]->ToNumber()->IntegerValue());
-    Persistent<Function> callback = Persistent<Function>::New(Handle<Function>::Cast(args[1]));
-    nodeArtist->on(ALBUMBROWSE_COMPLETE, callback);
-
-    //Mutate the V8 object.
-    Handle<Object> nodeArtistV8 = nodeArtist->getV8Object();
-    nodeArtistV8->SetAccessor(String::NewSymbol("tracks"), getTracks);
-    nodeArtistV8->SetAccessor(String::NewSymbol("tophitTracks"), getTophitTracks);
-    nodeArtistV8->SetAccessor(String::NewSymbol("albums"), getAlbums);
-    nodeArtistV8->SetAccessor(String::NewSymbol("similarArtists"), getSimilarArtists);
-    nodeArtistV8->SetAccessor(String::NewSymbol("biography"), getBiography);
-    //TODO: portraits
-
-    nodeArtist->artist->browse(artistbrowseType);
-  } else {
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(args[1], callback);
+  if(!callback.IsEmpty()) {
+    nodeArtist->once(ARTISTBROWSE_COMPLETE, callback);
+  }
+  sp_artistbrowse_type artistbrowseType = static_cast<sp_artistbrowse_type>(args[0]->ToNumber()->IntegerValue());
+  bool started = nodeArtist->artist->artistBrowse != nullptr || nodeArtist->artist->browseRequest != 0;
+  if(started && !nodeArtist->artist->browseIncludes(artistbrowseType)) {
+    //the waiting callbacks get the result of the fuller browse
+    nodeArtist->artist->dispose();
+  }
+  if(nodeArtist->artist->artistBrowse == nullptr && nodeArtist->artist->browseRequest == 0) {
+    RequestOptions options = RequestUtils::parseOptions(RequestUtils::optionsArgument(args, 2));
+    nodeArtist->artist->browse(artistbrowseType, options.priority, options.timeout);
+  } else if(nodeArtist->artist->isBrowsed()) {
     nodeArtist->call(ARTISTBROWSE_COMPLETE);
   }
-  return scope.Close(Undefined());
+  return scope.Close(promise);
+}
+
+/**
+ * The browse properties (tracks, tophitTracks, albums, similarArtists, biography) are empty until browsed is true.
+ **/
+Handle<Value> NodeArtist::getBrowsed(Local<String> property, const AccessorInfo& info) {
+  NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(info.Holder());
+  return Boolean::New(nodeArtist->artist->isBrowsed());
 }
 
 Handle<Value> NodeArtist::getTracks(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(info.Holder());
-  std::vector<std::shared_ptr<Track>> tracks = nodeArtist->artist->tracks();
-  Local<Array> nodeTracks = Array::New(tracks.size());
-  for(int i = 0; i < (int)tracks.size(); i++) {
-    NodeTrack* nodeTrack = new NodeTrack(tracks[i]);
-    nodeTracks->Set(Number::New(i), nodeTrack->getV8Object());
-  }
-  return scope.Close(nodeTracks);
+  return scope.Close(NodeList<Track>::fromVector(nodeArtist->artist->tracks()));
 }
 
 Handle<Value> NodeArtist::getTophitTracks(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(info.Holder());
-  std::vector<std::shared_ptr<Track>> tophitTracks = nodeArtist->artist->tophitTracks();
-  Local<Array> nodeTophitTracks = Array::New(tophitTracks.size());
-  for(int i = 0; i < (int)tophitTracks.size(); i++) {
-    NodeTrack* nodeTrack = new NodeTrack(tophitTracks[i]);
-    nodeTophitTracks->Set(Number::New(i), nodeTrack->getV8Object());
-  }
-  return scope.Close(nodeTophitTracks);
+  return scope.Close(NodeList<Track>::fromVector(nodeArtist->artist->tophitTracks()));
 }
 
 Handle<Value> NodeArtist::getAlbums(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(info.Holder());
-  std::vector<std::shared_ptr<Album>> albums = nodeArtist->artist->albums();
-  Local<Array> nodeAlbums = Array::New(albums.size());
-  for(int i = 0; i < (int)albums.size(); i++) {
-    NodeAlbum* nodeAlbum = new NodeAlbum(albums[i]);
-    nodeAlbums->Set(Number::New(i), nodeAlbum->getV8Object());
-  }
-  return scope.Close(nodeAlbums);
+  return scope.Close(NodeList<Album>::fromVector(nodeArtist->artist->albums()));
 }
 
 Handle<Value> NodeArtist::getSimilarArtists(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(info.Holder());
-  std::vector<std::shared_ptr<Artist>> similarArtists = nodeArtist->artist->similarArtists();
-  Local<Array> nodeSimilarArtists = Array::New(similarArtists.size());
-  for(int i = 0; i < (int)similarArtists.size(); i++) {
-    NodeArtist* nodeArtist = new NodeArtist(similarArtists[i]);
-    nodeSimilarArtists->Set(Number::New(i), nodeArtist->getV8Object());
-  }
-  return scope.Close(nodeSimilarArtists);
+  return scope.Close(NodeList<Artist>::fromVector(nodeArtist->artist->similarArtists()));
 }
 
 Handle<Value> NodeArtist::getBiography(Local<String> property, const AccessorInfo& info) {
@@ -119,12 +122,47 @@ Handle<Value> NodeArtist::getBiography(Local<String> property, const AccessorInf
   return scope.Close(String::New(biography.c_str()));
 }
 
+/**
+ * Releases the browse result now instead of waiting for the garbage collector.
+ * A pending browse is cancelled, its callbacks are called with an error.
+ **/
+Handle<Value> NodeArtist::dispose(const Arguments& args) {
+  HandleScope scope;
+  NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(args.This());
+  bool pending = nodeArtist->artist->browseRequest != 0;
+  nodeArtist->artist->dispose();
+  if(pending) {
+    nodeArtist->callError(ARTISTBROWSE_COMPLETE, "Artist browse cancelled");
+  }
+  return scope.Close(Undefined());
+}
+
+/**
+ * Serializes the artist natively, see JsonUtils::toJSON for the arguments.
+ **/
+Handle<Value> NodeArtist::toJSON(const Arguments& args) {
+  NodeArtist* nodeArtist = node::ObjectWrap::Unwrap<NodeArtist>(args.This());
+  std::shared_ptr<Artist> artist = nodeArtist->artist;
+  return JsonUtils::toJSON(args, [artist](JsonWriter& writer, int depth, int trackFields) {
+    JsonSerializer::artist(writer, *artist, depth, trackFields);
+  });
+}
+
 void NodeArtist::init() {
   HandleScope scope;
   Handle<FunctionTemplate> constructorTemplate = NodeWrapped::init("Artist");
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("name"), getName, emptySetter);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("link"), getLink, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("browsed"), getBrowsed, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("tracks"), getTracks, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("tophitTracks"), getTophitTracks, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("albums"), getAlbums, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("similarArtists"), getSimilarArtists, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("biography"), getBiography, emptySetter);
+  //TODO: portraits
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "browse", browse);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "dispose", dispose);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "toJSON", toJSON);
   constructor = Persistent<Function>::New(constructorTemplate->GetFunction());
   scope.Close(Undefined());
 }
\ No newline at end of file
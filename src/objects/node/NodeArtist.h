@@ -32,25 +32,38 @@ THE SOFTWARE.
 using namespace v8;
 
 class NodeArtist : public NodeWrappedWithCallbacks<NodeArtist> {
+friend class NodeSpotify;
 private:
   std::shared_ptr<Artist> artist;
 public:
   NodeArtist(std::shared_ptr<Artist> _artist) : artist(_artist) {
     artist->nodeObject = this;
   };
+  /**
+   * Runs when the Javascript object was garbage collected. Nothing can read the browse result anymore,
+   * so it is released now instead of when the last C++ reference to the artist is gone.
+   * A pending browse refs the object, so normally there is none here, it is never cancelled from the destructor.
+   **/
   ~NodeArtist() {
     if(artist->nodeObject == this) {
       artist->nodeObject = nullptr;
+      if(artist->browseRequest == 0) {
+        artist->dispose();
+      }
     }
   }
   static Handle<Value> getName(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getLink(Local<String> property, const AccessorInfo& info);
   static Handle<Value> browse(const Arguments& args);
+  static Handle<Value> dispose(const Arguments& args);
+  static Handle<Value> getBrowsed(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTracks(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTophitTracks(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getAlbums(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getSimilarArtists(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getBiography(Local<String> property, const AccessorInfo& info);
+  static Handle<Object> fromArtist(std::shared_ptr<Artist> artist);
+  static Handle<Value> toJSON(const Arguments& args);
   static void init();
 };
 
@@ -0,0 +1,151 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _NODE_LIST_H
+#define _NODE_LIST_H
+
+#include <vector>
+#include <memory>
+
+#include "NodeWrapped.h"
+
+/**
+ * A read only, array like Javascript object over a vector of spotify objects.
+ * The Javascript objects for the items are only created when an index is accessed,
+ * so getting a list of 10000 tracks and showing 50 of them creates 50 NodeTracks.
+ * Supports list[i], list.length, list.slice(offset, limit) and list.toArray().
+ * Methods for lists of one item type can be added with the extender passed to init.
+ **/
+template <class T>
+class NodeList : public NodeWrapped<NodeList<T>> {
+public:
+  typedef v8::Handle<v8::Object> (*ItemWrapper)(std::shared_ptr<T>);
+  typedef void (*TemplateExtender)(v8::Handle<v8::FunctionTemplate>);
+  NodeList(std::vector<std::shared_ptr<T>> _items) : items(_items) {};
+
+  /**
+   * Must be called once per item type before lists of that type can be created.
+   **/
+  static void init(const char* className, ItemWrapper _itemWrapper, TemplateExtender extender = nullptr) {
+    v8::HandleScope scope;
+    itemWrapper = _itemWrapper;
+    v8::Handle<v8::FunctionTemplate> constructorTemplate = NodeWrapped<NodeList<T>>::init(className);
+    NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "slice", slice);
+    NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "toArray", toArray);
+    if(extender != nullptr) {
+      extender(constructorTemplate);
+    }
+    v8::Handle<v8::ObjectTemplate> instanceTemplate = constructorTemplate->InstanceTemplate();
+    instanceTemplate->SetAccessor(v8::String::NewSymbol("length"), getLength, NodeWrapped<NodeList<T>>::emptySetter);
+    instanceTemplate->SetIndexedPropertyHandler(getItem, 0, queryItem, 0, enumerateItems);
+    NodeWrapped<NodeList<T>>::constructor = v8::Persistent<v8::Function>::New(constructorTemplate->GetFunction());
+    scope.Close(v8::Undefined());
+  }
+
+  static v8::Handle<v8::Object> fromVector(std::vector<std::shared_ptr<T>> items) {
+    NodeList<T>* nodeList = new NodeList<T>(items);
+    return nodeList->getV8Object();
+  }
+
+  const std::vector<std::shared_ptr<T>>& getItems() {
+    return items;
+  }
+private:
+  std::vector<std::shared_ptr<T>> items;
+  static ItemWrapper itemWrapper;
+
+  static v8::Handle<v8::Value> getItem(uint32_t index, const v8::AccessorInfo& info) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(info.Holder());
+    if(index >= nodeList->items.size()) {
+      //not intercepted
+      return v8::Handle<v8::Value>();
+    }
+    return scope.Close(itemWrapper(nodeList->items[index]));
+  }
+
+  static v8::Handle<v8::Integer> queryItem(uint32_t index, const v8::AccessorInfo& info) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(info.Holder());
+    if(index >= nodeList->items.size()) {
+      return v8::Handle<v8::Integer>();
+    }
+    return scope.Close(v8::Integer::New(v8::ReadOnly | v8::DontDelete));
+  }
+
+  static v8::Handle<v8::Array> enumerateItems(const v8::AccessorInfo& info) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(info.Holder());
+    v8::Local<v8::Array> indices = v8::Array::New(nodeList->items.size());
+    for(int i = 0; i < (int)nodeList->items.size(); i++) {
+      indices->Set(i, v8::Integer::New(i));
+    }
+    return scope.Close(indices);
+  }
+
+  static v8::Handle<v8::Value> getLength(v8::Local<v8::String> property, const v8::AccessorInfo& info) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(info.Holder());
+    return scope.Close(v8::Integer::New(nodeList->items.size()));
+  }
+
+  static v8::Handle<v8::Array> toArray(NodeList<T>* nodeList, int offset, int limit) {
+    v8::HandleScope scope;
+    v8::Local<v8::Array> out = v8::Array::New(limit);
+    for(int i = 0; i < limit; i++) {
+      out->Set(i, itemWrapper(nodeList->items[offset + i]));
+    }
+    return scope.Close(out);
+  }
+
+  /**
+   * Returns an array with the Javascript objects of limit items starting at offset.
+   * Without a limit all items from offset to the end are returned.
+   **/
+  static v8::Handle<v8::Value> slice(const v8::Arguments& args) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(args.This());
+    int size = nodeList->items.size();
+    int offset = args[0]->IsNumber() ? args[0]->IntegerValue() : 0;
+    if(offset < 0) {
+      offset = 0;
+    } else if(offset > size) {
+      offset = size;
+    }
+    int limit = args[1]->IsNumber() ? args[1]->IntegerValue() : size;
+    if(limit < 0 || limit > size - offset) {
+      limit = size - offset;
+    }
+    return scope.Close(toArray(nodeList, offset, limit));
+  }
+
+  static v8::Handle<v8::Value> toArray(const v8::Arguments& args) {
+    v8::HandleScope scope;
+    NodeList<T>* nodeList = node::ObjectWrap::Unwrap<NodeList<T>>(args.This());
+    return scope.Close(toArray(nodeList, 0, nodeList->items.size()));
+  }
+};
+
+template <class T> typename NodeList<T>::ItemWrapper NodeList<T>::itemWrapper;
+#endif
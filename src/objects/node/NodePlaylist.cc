@@ -26,9 +26,34 @@ THE SOFTWARE.
 #include "../../events.h"
 #include "../spotify/Track.h"
 #include "NodeTrack.h"
+#include "NodeList.h"
+#include "../../Application.h"
+#include "../../utils/TypedArrayUtils.h"
+#include "../../utils/Symbols.h"
+#include "../../utils/JsonUtils.h"
+#include "../../utils/PromiseUtils.h"
+#include "../../utils/PersistentUtils.h"
+#include "../spotify/JsonSerializer.h"
 
-void NodePlaylist::setName(Local<String> property, Local<Value> value, const AccessorInfo& info) {
+#include <node.h>
+#include <node_buffer.h>
+
+extern Application* application;
+
+/**
+ * Returns the Javascript object of the playlist. While it is not garbage collected the same object is returned.
+ **/
+Handle<Object> NodePlaylist::fromPlaylist(std::shared_ptr<Playlist> playlist) {
+  if(playlist->nodeObject != nullptr) {
+    return static_cast<NodePlaylist*>(playlist->nodeObject)->getV8Object();
+  }
+  NodePlaylist* nodePlaylist = new NodePlaylist(playlist);
+  return nodePlaylist->getV8Object();
+}
 
+void NodePlaylist::setName(Local<String> property, Local<Value> value, const AccessorInfo& info) {
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(info.Holder());
+  nodePlaylist->playlist->rename(*String::Utf8Value(value->ToString()));
 }
 
 Handle<Value> NodePlaylist::getName(Local<String> property, const AccessorInfo& info) {
@@ -49,13 +74,231 @@ Handle<Value> NodePlaylist::getId(Local<String> property, const AccessorInfo& in
 Handle<Value> NodePlaylist::getTracks(const Arguments& args) {
   HandleScope scope;
   NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
-  std::vector<std::shared_ptr<Track>> tracks = nodePlaylist->playlist->getTracks();
-  Local<Array> outArray = Array::New(tracks.size());
-  for(int i = 0; i < (int)tracks.size(); i++) {
-    NodeTrack* nodeTrack = new NodeTrack(tracks[i]);
-    outArray->Set(Number::New(i), nodeTrack->getV8Object());
+  return scope.Close(NodeList<Track>::fromVector(nodePlaylist->playlist->getTracks()));
+}
+
+/**
+ * Ends an edit: calls back with an error right away or, if it worked, with the playlist once libspotify synchronized the changes.
+ * Without a callback and promise factory errors are thrown.
+ * For edits that are split into chunks applied is the number of tracks that were changed before the error, it is
+ * added to the message and set as error.applied. The synchronization of these changes is not waited for.
+ **/
+static Handle<Value> finishEdit(std::shared_ptr<Playlist> playlist, sp_error error, Handle<Object> nodePlaylist, Handle<Value> callbackArgument, int applied = -1) {
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(callbackArgument, callback);
+  if(error != SP_ERROR_OK) {
+    std::string message = sp_error_message(error);
+    if(applied >= 0) {
+      message += " (" + std::to_string(applied) + " tracks were applied)";
+    }
+    Handle<Value> exception = Exception::Error(String::New(message.c_str()));
+    if(applied >= 0) {
+      exception->ToObject()->Set(Symbols::applied, Integer::New(applied));
+    }
+    if(callback.IsEmpty()) {
+      return ThrowException(exception);
+    }
+    Handle<Value> argv[2] = {exception, Undefined()};
+    callback->Call(Context::GetCurrent()->Global(), 2, argv);
+  } else if(!callback.IsEmpty()) {
+    Persistent<Function> persistentCallback = PersistentUtils::create(callback);
+    Persistent<Object> persistentPlaylist = PersistentUtils::create(nodePlaylist);
+    playlist->whenSynced([persistentCallback, persistentPlaylist](bool synced) mutable {
+      HandleScope scope;
+      Handle<Value> argv[2] = {Undefined(), persistentPlaylist};
+      if(!synced) {
+        argv[0] = Exception::Error(String::New("The changes were not synchronized before logout"));
+        argv[1] = Undefined();
+      }
+      //an exception must not keep the callbacks of the other edits from being called
+      TryCatch tryCatch;
+      persistentCallback->Call(Context::GetCurrent()->Global(), 2, argv);
+      PersistentUtils::dispose(persistentCallback);
+      PersistentUtils::dispose(persistentPlaylist);
+      if(tryCatch.HasCaught()) {
+        node::FatalException(tryCatch);
+      }
+      scope.Close(Undefined());
+    });
+  }
+  return promise;
+}
+
+/**
+ * Reads track positions from an array of numbers or an Int32Array/Uint32Array (e.g. from playlistOps with indices).
+ * Returns false if it is neither.
+ **/
+static bool toIndices(Handle<Value> value, std::vector<int>& indices) {
+  if(TypedArrayUtils::toVector(value, indices)) {
+    return true;
   }
-  return scope.Close(outArray);
+  if(!value->IsArray()) {
+    return false;
+  }
+  Handle<Array> array = Handle<Array>::Cast(value);
+  indices.resize(array->Length());
+  for(int i = 0; i < (int)indices.size(); i++) {
+    Handle<Value> index = array->Get(i);
+    if(!index->IsNumber()) {
+      return false;
+    }
+    indices[i] = index->Int32Value();
+  }
+  return true;
+}
+
+/**
+ * playlist.addTracks(tracks, [position], [callback]) adds the tracks at position or at the end.
+ * The callback gets the playlist when the change is synchronized, without a callback a promise is returned.
+ **/
+Handle<Value> NodePlaylist::addTracks(const Arguments& args) {
+  HandleScope scope;
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  std::vector<std::shared_ptr<Track>> tracks;
+  if(!NodeTrack::toTracks(args[0], tracks)) {
+    return scope.Close(ThrowException(Exception::Error(String::New("addTracks expects an array of tracks"))));
+  }
+  bool hasPosition = args[1]->IsNumber();
+  int position = hasPosition ? args[1]->Int32Value() : -1;
+  int applied;
+  sp_error error = nodePlaylist->playlist->addTracks(tracks, position, applied);
+  return scope.Close(finishEdit(nodePlaylist->playlist, error, args.This(), hasPosition ? args[2] : args[1], applied));
+}
+
+/**
+ * playlist.removeTracks(positions, [callback]) removes the tracks at the given positions.
+ **/
+Handle<Value> NodePlaylist::removeTracks(const Arguments& args) {
+  HandleScope scope;
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  std::vector<int> indices;
+  if(!toIndices(args[0], indices)) {
+    return scope.Close(ThrowException(Exception::Error(String::New("removeTracks expects an array of track positions"))));
+  }
+  int applied;
+  sp_error error = nodePlaylist->playlist->removeTracks(indices, applied);
+  return scope.Close(finishEdit(nodePlaylist->playlist, error, args.This(), args[1], applied));
+}
+
+/**
+ * playlist.reorderTracks(positions, newPosition, [callback]) moves the tracks at positions in front of the track at newPosition.
+ **/
+Handle<Value> NodePlaylist::reorderTracks(const Arguments& args) {
+  HandleScope scope;
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  std::vector<int> indices;
+  if(!toIndices(args[0], indices) || !args[1]->IsNumber()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("reorderTracks expects an array of track positions and the new position"))));
+  }
+  sp_error error = nodePlaylist->playlist->reorderTracks(indices, args[1]->Int32Value());
+  return scope.Close(finishEdit(nodePlaylist->playlist, error, args.This(), args[2]));
+}
+
+/**
+ * playlist.rename(name, [callback]), playlist.name = name does the same without a callback.
+ **/
+Handle<Value> NodePlaylist::rename(const Arguments& args) {
+  HandleScope scope;
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  sp_error error = nodePlaylist->playlist->rename(*String::Utf8Value(args[0]->ToString()));
+  return scope.Close(finishEdit(nodePlaylist->playlist, error, args.This(), args[1]));
+}
+
+Handle<Value> NodePlaylist::getOffline(Local<String> property, const AccessorInfo& info) {
+  if(!application->playlistContainer) {
+    return Undefined();
+  }
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(info.Holder());
+  sp_playlist_offline_status status = application->playlistContainer->offlineStatus(nodePlaylist->playlist);
+  return Boolean::New(status != SP_PLAYLIST_OFFLINE_STATUS_NO);
+}
+
+void NodePlaylist::setOffline(Local<String> property, Local<Value> value, const AccessorInfo& info) {
+  if(!application->playlistContainer) {
+    ThrowException(Exception::Error(String::New("Playlists can only be made available offline while logged in")));
+    return;
+  }
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(info.Holder());
+  application->playlistContainer->setOfflineMode(nodePlaylist->playlist, value->ToBoolean()->Value());
+}
+
+Handle<Value> NodePlaylist::getOfflineStatus(Local<String> property, const AccessorInfo& info) {
+  if(!application->playlistContainer) {
+    return Undefined();
+  }
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(info.Holder());
+  return Integer::New(application->playlistContainer->offlineStatus(nodePlaylist->playlist));
+}
+
+Handle<Value> NodePlaylist::getOfflineDownloadCompleted(Local<String> property, const AccessorInfo& info) {
+  if(!application->playlistContainer) {
+    return Undefined();
+  }
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(info.Holder());
+  return Integer::New(application->playlistContainer->offlineDownloadCompleted(nodePlaylist->playlist));
+}
+
+static Handle<Object> stringColumnToObject(StringColumn& stringColumn) {
+  Local<Object> out = Object::New();
+  node::Buffer* buffer = node::Buffer::New(stringColumn.data.data(), stringColumn.data.size());
+  out->Set(Symbols::data, buffer->handle_);
+  out->Set(Symbols::offsets, TypedArrayUtils::fromVector(stringColumn.offsets));
+  return out;
+}
+
+/**
+ * Exports metadata of all tracks in one call, e.g. playlist.exportColumns(['name', 'duration']). Without fields all columns are exported.
+ * Numeric columns are typed arrays (duration in ms, popularity, starred as 0/1, createTime in seconds since the epoch).
+ * String columns (name, link, artist, album) are objects { data: Buffer, offsets: Uint32Array },
+ * the string of track i is data.toString('utf8', offsets[i], offsets[i + 1]).
+ **/
+Handle<Value> NodePlaylist::exportColumns(const Arguments& args) {
+  HandleScope scope;
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  int columns = NodeTrack::parseFields(args[0]);
+  if(columns == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Unknown column"))));
+  }
+
+  TrackColumns trackColumns = nodePlaylist->playlist->exportColumns(columns);
+  Local<Object> out = Object::New();
+  out->Set(Symbols::length, Integer::New(trackColumns.numTracks));
+  if(columns & COLUMN_DURATION) {
+    out->Set(Symbols::duration, TypedArrayUtils::fromVector(trackColumns.duration));
+  }
+  if(columns & COLUMN_POPULARITY) {
+    out->Set(Symbols::popularity, TypedArrayUtils::fromVector(trackColumns.popularity));
+  }
+  if(columns & COLUMN_STARRED) {
+    out->Set(Symbols::starred, TypedArrayUtils::fromVector(trackColumns.starred));
+  }
+  if(columns & COLUMN_CREATE_TIME) {
+    out->Set(Symbols::createTime, TypedArrayUtils::fromVector(trackColumns.createTime));
+  }
+  if(columns & COLUMN_NAME) {
+    out->Set(Symbols::name, stringColumnToObject(trackColumns.name));
+  }
+  if(columns & COLUMN_LINK) {
+    out->Set(Symbols::link, stringColumnToObject(trackColumns.link));
+  }
+  if(columns & COLUMN_ARTIST) {
+    out->Set(Symbols::artist, stringColumnToObject(trackColumns.artist));
+  }
+  if(columns & COLUMN_ALBUM) {
+    out->Set(Symbols::album, stringColumnToObject(trackColumns.album));
+  }
+  return scope.Close(out);
+}
+
+/**
+ * Serializes the playlist natively, see JsonUtils::toJSON for the arguments.
+ **/
+Handle<Value> NodePlaylist::toJSON(const Arguments& args) {
+  NodePlaylist* nodePlaylist = node::ObjectWrap::Unwrap<NodePlaylist>(args.This());
+  std::shared_ptr<Playlist> playlist = nodePlaylist->playlist;
+  return JsonUtils::toJSON(args, [playlist](JsonWriter& writer, int depth, int trackFields) {
+    JsonSerializer::playlist(writer, *playlist, depth, trackFields);
+  });
 }
 
 void NodePlaylist::init() {
@@ -65,7 +308,16 @@ void NodePlaylist::init() {
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("name"), getName, setName);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("link"), getLink, emptySetter);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("id"), getId, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("offline"), getOffline, setOffline);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("offlineStatus"), getOfflineStatus, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("offlineDownloadCompleted"), getOfflineDownloadCompleted, emptySetter);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getTracks", getTracks);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "addTracks", addTracks);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "removeTracks", removeTracks);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "reorderTracks", reorderTracks);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "rename", rename);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "exportColumns", exportColumns);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "toJSON", toJSON);
 
   constructor = Persistent<Function>::New(constructorTemplate->GetFunction());
   scope.Close(Undefined());
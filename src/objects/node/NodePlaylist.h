@@ -33,6 +33,8 @@ THE SOFTWARE.
 using namespace v8;
 
 class NodePlaylist : public NodeWrappedWithCallbacks<NodePlaylist> {
+friend class NodeSpotify;
+friend class NodePlaylistOps;
 private:
   std::shared_ptr<Playlist> playlist;
 public:
@@ -49,7 +51,18 @@ public:
   static Handle<Value> getLink(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getId(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTracks(const Arguments& args);
+  static Handle<Value> addTracks(const Arguments& args);
+  static Handle<Value> removeTracks(const Arguments& args);
+  static Handle<Value> reorderTracks(const Arguments& args);
+  static Handle<Value> rename(const Arguments& args);
+  static Handle<Value> exportColumns(const Arguments& args);
+  static Handle<Value> getOffline(Local<String> property, const AccessorInfo& info);
+  static void setOffline(Local<String> property, Local<Value> value, const AccessorInfo& info);
+  static Handle<Value> getOfflineStatus(Local<String> property, const AccessorInfo& info);
+  static Handle<Value> getOfflineDownloadCompleted(Local<String> property, const AccessorInfo& info);
 
+  static Handle<Object> fromPlaylist(std::shared_ptr<Playlist> playlist);
+  static Handle<Value> toJSON(const Arguments& args);
   static void init();
 };
 
@@ -0,0 +1,123 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "NodePlaylistOps.h"
+#include "NodePlaylist.h"
+#include "NodeTrack.h"
+#include "NodeList.h"
+#include "../../utils/Symbols.h"
+#include "../../utils/TypedArrayUtils.h"
+
+/**
+ * Takes the tracks of a playlist (from its native track mirror) or of an array of tracks.
+ **/
+bool NodePlaylistOps::toTracks(Handle<Value> value, std::vector<std::shared_ptr<Track>>& tracks) {
+  if(NodePlaylist::isInstance(value)) {
+    tracks = node::ObjectWrap::Unwrap<NodePlaylist>(value->ToObject())->playlist->getTracks();
+    return true;
+  }
+  return NodeTrack::toTracks(value, tracks);
+}
+
+bool NodePlaylistOps::option(Handle<Value> options, Handle<String> name) {
+  return options->IsObject() && options->ToObject()->Get(name)->BooleanValue();
+}
+
+Handle<Value> NodePlaylistOps::apply(const Arguments& args, Operation operation) {
+  HandleScope scope;
+  std::vector<std::shared_ptr<Track>> a;
+  std::vector<std::shared_ptr<Track>> b;
+  if(!toTracks(args[0], a) || !toTracks(args[1], b)) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Please provide two playlists or arrays of tracks"))));
+  }
+  TrackSets::Selection selection = operation(a, b, option(args[2], Symbols::fuzzy));
+  if(option(args[2], Symbols::indices)) {
+    Local<Object> out = Object::New();
+    out->Set(Symbols::a, TypedArrayUtils::fromVector(selection.a));
+    out->Set(Symbols::b, TypedArrayUtils::fromVector(selection.b));
+    return scope.Close(out);
+  }
+  std::vector<std::shared_ptr<Track>> tracks;
+  tracks.reserve(selection.a.size() + selection.b.size());
+  for(auto it = selection.a.begin(); it != selection.a.end(); it++) {
+    tracks.push_back(a[*it]);
+  }
+  for(auto it = selection.b.begin(); it != selection.b.end(); it++) {
+    tracks.push_back(b[*it]);
+  }
+  return scope.Close(NodeList<Track>::fromVector(tracks));
+}
+
+/**
+ * playlistOps.intersect(a, b, [options]): the tracks of a that are also in b.
+ **/
+Handle<Value> NodePlaylistOps::intersect(const Arguments& args) {
+  return apply(args, &TrackSets::intersect);
+}
+
+/**
+ * playlistOps.difference(a, b, [options]): the tracks of a that are not in b, e.g. what is new in a.
+ **/
+Handle<Value> NodePlaylistOps::difference(const Arguments& args) {
+  return apply(args, &TrackSets::difference);
+}
+
+/**
+ * playlistOps.union(a, b, [options]): the tracks of a followed by the tracks of b that are not in a.
+ **/
+Handle<Value> NodePlaylistOps::unite(const Arguments& args) {
+  return apply(args, &TrackSets::unite);
+}
+
+/**
+ * playlistOps.duplicates(a, [options]): the tracks that are in a more than once, without their first occurrence.
+ * With indices the positions can be passed to playlist.removeTracks.
+ **/
+Handle<Value> NodePlaylistOps::duplicates(const Arguments& args) {
+  HandleScope scope;
+  std::vector<std::shared_ptr<Track>> a;
+  if(!toTracks(args[0], a)) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Please provide a playlist or an array of tracks"))));
+  }
+  std::vector<uint32_t> positions = TrackSets::duplicates(a, option(args[1], Symbols::fuzzy));
+  if(option(args[1], Symbols::indices)) {
+    return scope.Close(TypedArrayUtils::fromVector(positions));
+  }
+  std::vector<std::shared_ptr<Track>> tracks(positions.size());
+  for(size_t i = 0; i < positions.size(); i++) {
+    tracks[i] = a[positions[i]];
+  }
+  return scope.Close(NodeList<Track>::fromVector(tracks));
+}
+
+void NodePlaylistOps::init(Handle<Object> target, const char* name) {
+  HandleScope scope;
+  Local<Object> playlistOps = Object::New();
+  playlistOps->Set(String::NewSymbol("intersect"), FunctionTemplate::New(intersect)->GetFunction());
+  playlistOps->Set(String::NewSymbol("difference"), FunctionTemplate::New(difference)->GetFunction());
+  playlistOps->Set(String::NewSymbol("union"), FunctionTemplate::New(unite)->GetFunction());
+  playlistOps->Set(String::NewSymbol("duplicates"), FunctionTemplate::New(duplicates)->GetFunction());
+  target->Set(String::NewSymbol(name), playlistOps);
+  scope.Close(Undefined());
+}
@@ -0,0 +1,57 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _NODE_PLAYLIST_OPS_H
+#define _NODE_PLAYLIST_OPS_H
+
+#include <node.h>
+#include <vector>
+#include <memory>
+
+#include "../spotify/Track.h"
+#include "../spotify/TrackSets.h"
+
+using namespace v8;
+
+/**
+ * spotify.playlistOps: set operations on playlists (or arrays of tracks) computed natively, see TrackSets.
+ * The functions take an options object {fuzzy, indices} as their last argument. With fuzzy tracks with the same
+ * name, artists and duration count as the same track. Results are lazy track lists, with indices the positions
+ * of the tracks in the arguments as Uint32Arrays.
+ **/
+class NodePlaylistOps {
+public:
+  static Handle<Value> intersect(const Arguments& args);
+  static Handle<Value> difference(const Arguments& args);
+  static Handle<Value> unite(const Arguments& args);
+  static Handle<Value> duplicates(const Arguments& args);
+  static void init(Handle<Object> target, const char* name);
+private:
+  typedef TrackSets::Selection (*Operation)(const std::vector<std::shared_ptr<Track>>&, const std::vector<std::shared_ptr<Track>>&, bool);
+  static Handle<Value> apply(const Arguments& args, Operation operation);
+  static bool toTracks(Handle<Value> value, std::vector<std::shared_ptr<Track>>& tracks);
+  static bool option(Handle<Value> options, Handle<String> name);
+};
+
+#endif
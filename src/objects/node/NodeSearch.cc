@@ -24,60 +24,87 @@ THE SOFTWARE.
 
 #include "NodeSearch.h"
 #include "NodeTrack.h"
+#include "NodeList.h"
 #include "NodeAlbum.h"
 #include "NodeArtist.h"
 #include "NodePlaylist.h"
 #include "../../events.h"
 #include "../../Application.h"
+#include "../../utils/PromiseUtils.h"
+#include "../../utils/RequestUtils.h"
+#include "../../utils/JsonUtils.h"
+#include "../spotify/JsonSerializer.h"
+
+#include <sstream>
 
 extern Application* application;
 
-NodeSearch::NodeSearch(const char* _searchQuery) : searchQuery(_searchQuery), trackOffset(0), albumOffset(0), artistOffset(0), playlistOffset(0),
+NodeSearch::NodeSearch(const char* _searchQuery) : search(std::make_shared<Search>()), searchQuery(_searchQuery), trackOffset(0), albumOffset(0), artistOffset(0), playlistOffset(0),
   trackLimit(10), albumLimit(10), artistLimit(10), playlistLimit(10) {
 
 }
 
-NodeSearch::NodeSearch(const char* _searchQuery, int offset) : searchQuery(_searchQuery), trackOffset(offset), albumOffset(offset), artistOffset(offset), playlistOffset(offset),
+NodeSearch::NodeSearch(const char* _searchQuery, int offset) : search(std::make_shared<Search>()), searchQuery(_searchQuery), trackOffset(offset), albumOffset(offset), artistOffset(offset), playlistOffset(offset),
   trackLimit(10), albumLimit(10), artistLimit(10), playlistLimit(10) {
 
 }
 
-NodeSearch::NodeSearch(const char* _searchQuery, int offset, int limit) : searchQuery(_searchQuery), trackOffset(offset), albumOffset(offset), artistOffset(offset), playlistOffset(offset),
+NodeSearch::NodeSearch(const char* _searchQuery, int offset, int limit) : search(std::make_shared<Search>()), searchQuery(_searchQuery), trackOffset(offset), albumOffset(offset), artistOffset(offset), playlistOffset(offset),
   trackLimit(limit), albumLimit(limit), artistLimit(limit), playlistLimit(limit) {
 
 }
 
+/**
+ * A string describing the query and all offsets and limits, to detect if a search can be reused.
+ **/
+std::string NodeSearch::parameters() {
+  std::stringstream parameters;
+  parameters << trackOffset << ':' << trackLimit << ':' << albumOffset << ':' << albumLimit << ':'
+    << artistOffset << ':' << artistLimit << ':' << playlistOffset << ':' << playlistLimit << ':' << searchQuery;
+  return parameters.str();
+}
+
+/**
+ * Execute the search. If the same search is already running or done all callers are called back with its result.
+ **/
 Handle<Value> NodeSearch::execute(const Arguments& args) {
   HandleScope scope;
   NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(args.This());
-  Persistent<Function> callback = Persistent<Function>::New(Handle<Function>::Cast(args[0]));
-  nodeSearch->on(SEARCH_COMPLETE, callback);
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(args[0], callback);
+  if(!callback.IsEmpty()) {
+    nodeSearch->once(SEARCH_COMPLETE, callback);
+  }
+  std::string parameters = nodeSearch->parameters();
+  if(nodeSearch->executedParameters == parameters) {
+    sp_search* spSearch = nodeSearch->search->search;
+    if(nodeSearch->search->request != 0) {
+      //still queued or running, the callback will be called when it is done
+      return scope.Close(promise);
+    } else if(spSearch != nullptr && sp_search_error(spSearch) == SP_ERROR_OK) {
+      nodeSearch->call(SEARCH_COMPLETE);
+      return scope.Close(promise);
+    }
+    //the search failed or timed out, try again
+  }
+  RequestOptions options = RequestUtils::parseOptions(RequestUtils::optionsArgument(args, 1));
+  nodeSearch->executedParameters = parameters;
   nodeSearch->search = std::make_shared<Search>();
   nodeSearch->search->nodeObject = nodeSearch;
   nodeSearch->search->execute(nodeSearch->searchQuery, nodeSearch->trackOffset, nodeSearch->trackLimit,
     nodeSearch->albumOffset, nodeSearch->albumLimit,
     nodeSearch->artistOffset, nodeSearch->artistLimit,
-    nodeSearch->playlistLimit, nodeSearch->playlistLimit);
-  nodeSearch->setupAdditionalMethods();
-  return scope.Close(Undefined());
+    nodeSearch->playlistOffset, nodeSearch->playlistLimit,
+    options.priority, options.timeout);
+  return scope.Close(promise);
 }
 
 /**
- * Adds adiitional properties to the V8 object.
- * These will call libspotify functions and should first be available when the search has been executed.
+ * The result properties (didYouMean, link, tracks, ...) are empty until loaded is true.
  **/
-void NodeSearch::setupAdditionalMethods() {
-  Handle<Object> nodeObject = this->getV8Object();
-  nodeObject->SetAccessor(String::NewSymbol("didYouMean"), didYouMean);
-  nodeObject->SetAccessor(String::NewSymbol("link"), getLink);
-  nodeObject->SetAccessor(String::NewSymbol("tracks"), getTracks);
-  nodeObject->SetAccessor(String::NewSymbol("albums"), getAlbums);
-  nodeObject->SetAccessor(String::NewSymbol("artists"), getArtists);
-  nodeObject->SetAccessor(String::NewSymbol("playlists"), getPlaylists);
-  nodeObject->SetAccessor(String::NewSymbol("totalTracks"), getTotalTracks);
-  nodeObject->SetAccessor(String::NewSymbol("totalAlbums"), getTotalAlbums);
-  nodeObject->SetAccessor(String::NewSymbol("totalArtists"), getTotalArtists);
-  nodeObject->SetAccessor(String::NewSymbol("totalPlaylists"), getTotalPlaylists);
+Handle<Value> NodeSearch::getLoaded(Local<String> property, const AccessorInfo& info) {
+  NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(info.Holder());
+  return Boolean::New(nodeSearch->search->isLoaded());
 }
 
 Handle<Value> NodeSearch::getTrackOffset(Local<String> property, const AccessorInfo& info) {
@@ -218,49 +245,25 @@ Handle<Value> NodeSearch::getLink(Local<String> property, const AccessorInfo& in
 Handle<Value> NodeSearch::getTracks(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(info.Holder());
-  std::vector<std::shared_ptr<Track>> tracks = nodeSearch->search->getTracks();
-  Local<Array> outArray = Array::New(tracks.size());
-  for(int i = 0; i < (int)tracks.size(); i++) {
-    NodeTrack* nodeTrack = new NodeTrack(tracks[i]);
-    outArray->Set(Number::New(i), nodeTrack->getV8Object());
-  }
-  return scope.Close(outArray);
+  return scope.Close(NodeList<Track>::fromVector(nodeSearch->search->getTracks()));
 }
 
 Handle<Value> NodeSearch::getAlbums(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(info.Holder());
-  std::vector<std::shared_ptr<Album>> albums = nodeSearch->search->getAlbums();
-  Local<Array> outArray = Array::New(albums.size());
-  for(int i = 0; i < (int)albums.size(); i++) {
-    NodeAlbum* nodeAlbum = new NodeAlbum(albums[i]);
-    outArray->Set(Number::New(i), nodeAlbum->getV8Object());
-  }
-  return scope.Close(outArray);
+  return scope.Close(NodeList<Album>::fromVector(nodeSearch->search->getAlbums()));
 }
 
 Handle<Value> NodeSearch::getArtists(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(info.Holder());
-  std::vector<std::shared_ptr<Artist>> artists = nodeSearch->search->getArtists();
-  Local<Array> outArray = Array::New(artists.size());
-  for(int i = 0; i < (int)artists.size(); i++) {
-    NodeArtist* nodeArtist = new NodeArtist(artists[i]);
-    outArray->Set(Number::New(i), nodeArtist->getV8Object());
-  }
-  return scope.Close(outArray);
+  return scope.Close(NodeList<Artist>::fromVector(nodeSearch->search->getArtists()));
 }
 
 Handle<Value> NodeSearch::getPlaylists(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(info.Holder());
-  std::vector<std::shared_ptr<Playlist>> playlists = nodeSearch->search->getPlaylists();
-  Local<Array> outArray = Array::New(playlists.size());
-  for(int i = 0; i < (int)playlists.size(); i++) {
-    NodePlaylist* nodePlaylist = new NodePlaylist(playlists[i]);
-    outArray->Set(Number::New(i), nodePlaylist->getV8Object());
-  }
-  return scope.Close(outArray);
+  return scope.Close(NodeList<Playlist>::fromVector(nodeSearch->search->getPlaylists()));
 }
 
 Handle<Value> NodeSearch::getTotalTracks(Local<String> property, const AccessorInfo& info) {
@@ -292,12 +295,40 @@ Handle<Function> NodeSearch::getConstructor() {
   return scope.Close(constructor);
 }
 
+/**
+ * Releases the search result now instead of waiting for the garbage collector.
+ * A pending search is cancelled, its callbacks are called with an error.
+ **/
+Handle<Value> NodeSearch::dispose(const Arguments& args) {
+  HandleScope scope;
+  NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(args.This());
+  bool pending = nodeSearch->search->request != 0;
+  nodeSearch->search->dispose();
+  if(pending) {
+    nodeSearch->callError(SEARCH_COMPLETE, "Search cancelled");
+  }
+  return scope.Close(Undefined());
+}
+
+/**
+ * Serializes the search result natively, see JsonUtils::toJSON for the arguments.
+ **/
+Handle<Value> NodeSearch::toJSON(const Arguments& args) {
+  NodeSearch* nodeSearch = node::ObjectWrap::Unwrap<NodeSearch>(args.This());
+  std::shared_ptr<Search> search = nodeSearch->search;
+  return JsonUtils::toJSON(args, [search](JsonWriter& writer, int depth, int trackFields) {
+    JsonSerializer::search(writer, *search, depth, trackFields);
+  });
+}
+
 void NodeSearch::init() {
 HandleScope scope;
   Local<FunctionTemplate> constructorTemplate = FunctionTemplate::New(New);
   constructorTemplate->SetClassName(String::NewSymbol("Search"));
   constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "execute", execute);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "dispose", dispose);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "toJSON", toJSON);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("trackOffset"), getTrackOffset, setTrackOffset);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("trackLimit"), getTrackLimit, setTrackLimit);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("albumOffset"), getAlbumOffset, setAlbumOffset);
@@ -306,6 +337,17 @@ HandleScope scope;
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("artistLimit"), getArtistLimit, setArtistLimit);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("playlistOffset"), getPlaylistOffset, setPlaylistOffset);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("playlistLimit"), getPlaylistLimit, setPlaylistLimit);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("loaded"), getLoaded, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("didYouMean"), didYouMean, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("link"), getLink, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("tracks"), getTracks, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("albums"), getAlbums, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("artists"), getArtists, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("playlists"), getPlaylists, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("totalTracks"), getTotalTracks, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("totalAlbums"), getTotalAlbums, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("totalArtists"), getTotalArtists, emptySetter);
+  constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("totalPlaylists"), getTotalPlaylists, emptySetter);
   constructor = Persistent<Function>::New(constructorTemplate->GetFunction());
   scope.Close(Undefined());
 }
\ No newline at end of file
@@ -35,9 +35,10 @@ class NodeSearch : public NodeWrappedWithCallbacks<NodeSearch> {
 private:
   std::shared_ptr<Search> search;
   std::string searchQuery;
+  std::string executedParameters;
   int trackOffset, albumOffset, artistOffset, playlistOffset;
   int trackLimit, albumLimit, artistLimit, playlistLimit;
-  void setupAdditionalMethods();
+  std::string parameters();
 public:
   NodeSearch(const char* _query);
   NodeSearch(const char* _query, int offset);
@@ -59,6 +60,7 @@ public:
   static void setArtistLimit(Local<String> property, Local<Value> value,  const AccessorInfo& info);
   static Handle<Value> getPlaylistLimit(Local<String> property, const AccessorInfo& info);
   static void setPlaylistLimit(Local<String> property, Local<Value> value,  const AccessorInfo& info);
+  static Handle<Value> getLoaded(Local<String> property, const AccessorInfo& info);
   static Handle<Value> didYouMean(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTotalTracks(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getTotalAlbums(Local<String> property, const AccessorInfo& info);
@@ -66,12 +68,14 @@ public:
   static Handle<Value> getTotalPlaylists(Local<String> property, const AccessorInfo& info);
   static Handle<Value> New(const Arguments& args);
   static Handle<Value> execute(const Arguments& args);
+  static Handle<Value> dispose(const Arguments& args);
   static Handle<Value> getTracks(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getAlbums(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getArtists(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getPlaylists(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getLink(Local<String> property, const AccessorInfo& info);
   static Handle<Function> getConstructor();
+  static Handle<Value> toJSON(const Arguments& args);
   static void init();
 };
 
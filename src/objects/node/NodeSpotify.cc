@@ -25,16 +25,70 @@ THE SOFTWARE.
 
 #include "NodeSpotify.h"
 #include "../../Application.h"
-#include "../../Callbacks/SessionCallbacks.h"
+#include "../../callbacks/SessionCallbacks.h"
 #include "../spotify/SpotifyOptions.h"
+#include "../../exceptions.h"
+#include "../../utils/PromiseUtils.h"
+#include "../../utils/Symbols.h"
+#include "../../utils/PersistentUtils.h"
 #include "NodePlaylist.h"
 #include "NodePlayer.h"
 #include "NodeArtist.h"
 #include "NodeAlbum.h"
 #include "NodeTrack.h"
 
+#include <map>
+#include <string>
+
 extern Application* application;
 
+/**
+ * The following functions convert Javascript values to libspotify settings. They return -1 for invalid values.
+ **/
+static int toCacheSize(Handle<Value> value) {
+  if(!value->IsNumber() || value->IntegerValue() < 0) {
+    return -1;
+  }
+  return value->IntegerValue();
+}
+
+static int toBitrate(Handle<Value> value) {
+  if(!value->IsNumber()) {
+    return -1;
+  }
+  switch(value->IntegerValue()) {
+    case 96:
+      return SP_BITRATE_96k;
+    case 160:
+      return SP_BITRATE_160k;
+    case 320:
+      return SP_BITRATE_320k;
+    default:
+      return -1;
+  }
+}
+
+static int toConnectionType(Handle<Value> value) {
+  if(!value->IsNumber() || value->IntegerValue() < SP_CONNECTION_TYPE_UNKNOWN || value->IntegerValue() > SP_CONNECTION_TYPE_WIRED) {
+    return -1;
+  }
+  return value->IntegerValue();
+}
+
+static int toConnectionRules(Handle<Value> value) {
+  int allRules = SP_CONNECTION_RULE_NETWORK | SP_CONNECTION_RULE_NETWORK_IF_ROAMING |
+    SP_CONNECTION_RULE_ALLOW_SYNC_OVER_MOBILE | SP_CONNECTION_RULE_ALLOW_SYNC_OVER_WIFI;
+  if(!value->IsNumber() || value->IntegerValue() < 0 || (value->IntegerValue() & ~allRules) != 0) {
+    return -1;
+  }
+  return value->IntegerValue();
+}
+
+static const char* cacheSizeError = "cacheSize must be a number of megabytes >= 0";
+static const char* bitrateError = "Bitrate must be one of 96, 160 or 320";
+static const char* connectionTypeError = "Connection type must be one of the spotify.CONNECTION_TYPE_* values";
+static const char* connectionRulesError = "Connection rules must be a combination of the spotify.CONNECTION_RULE_* values";
+
 NodeSpotify::NodeSpotify(Handle<Object> options) {
   /*
    * Important note: The session callbacks must be initialized before
@@ -47,10 +101,15 @@ NodeSpotify::NodeSpotify(Handle<Object> options) {
 
   SpotifyOptions _options;
   HandleScope scope;
-  Handle<String> settingsFolderKey = String::New("settingsFolder");
-  Handle<String> cacheFolderKey = String::New("cacheFolder");
-  Handle<String> traceFileKey = String::New("traceFile");
-  Handle<String> appkeyFileKey = String::New("appkeyFile");
+  Handle<String> settingsFolderKey = Symbols::settingsFolder;
+  Handle<String> cacheFolderKey = Symbols::cacheFolder;
+  Handle<String> traceFileKey = Symbols::traceFile;
+  Handle<String> appkeyFileKey = Symbols::appkeyFile;
+  Handle<String> cacheSizeKey = Symbols::cacheSize;
+  Handle<String> bitrateKey = Symbols::bitrate;
+  Handle<String> offlineBitrateKey = Symbols::offlineBitrate;
+  Handle<String> connectionTypeKey = Symbols::connectionType;
+  Handle<String> connectionRulesKey = Symbols::connectionRules;
   if(options->Has(settingsFolderKey)) {
     String::Utf8Value settingsFolderValue(options->Get(settingsFolderKey)->ToString());
     _options.settingsFolder = *settingsFolderValue;
@@ -71,55 +130,197 @@ NodeSpotify::NodeSpotify(Handle<Object> options) {
     String::Utf8Value appkeyFileValue(options->Get(appkeyFileKey)->ToString());
     _options.appkeyFile = *appkeyFileValue;
   }
+  if(options->Has(cacheSizeKey)) {
+    _options.cacheSize = toCacheSize(options->Get(cacheSizeKey));
+    if(_options.cacheSize == -1) {
+      throw OptionException(cacheSizeError);
+    }
+  }
+  if(options->Has(bitrateKey)) {
+    _options.preferredBitrate = toBitrate(options->Get(bitrateKey));
+    if(_options.preferredBitrate == -1) {
+      throw OptionException(bitrateError);
+    }
+  }
+  if(options->Has(offlineBitrateKey)) {
+    _options.preferredOfflineBitrate = toBitrate(options->Get(offlineBitrateKey));
+    if(_options.preferredOfflineBitrate == -1) {
+      throw OptionException(bitrateError);
+    }
+  }
+  if(options->Has(connectionTypeKey)) {
+    _options.connectionType = toConnectionType(options->Get(connectionTypeKey));
+    if(_options.connectionType == -1) {
+      throw OptionException(connectionTypeError);
+    }
+  }
+  if(options->Has(connectionRulesKey)) {
+    _options.connectionRules = toConnectionRules(options->Get(connectionRulesKey));
+    if(_options.connectionRules == -1) {
+      throw OptionException(connectionRulesError);
+    }
+  }
   spotify = std::unique_ptr<Spotify>(new Spotify(_options));
+  spotify->nodeObject = this;
   scope.Close(Undefined());
 }
 
+/**
+ * The error for a metadata waiter, undefined if everything was loaded.
+ **/
+static Handle<Value> loadError(LoadResult loadResult) {
+  switch(loadResult) {
+    case LOAD_TIMED_OUT:
+      return Exception::Error(String::New("Timed out waiting for metadata"));
+    case LOAD_LOGGED_OUT:
+      return Exception::Error(String::New("Logged out while waiting for metadata"));
+    default:
+      return Undefined();
+  }
+}
+
+/**
+ * Creates the Javascript object for a parsed link and adds it to loadSet. Returns an empty handle for unsupported link types.
+ **/
+static Handle<Value> objectFromLink(sp_link* link, LoadSet& loadSet) {
+  switch(sp_link_type(link)) {
+    case SP_LINKTYPE_TRACK:
+    case SP_LINKTYPE_LOCALTRACK:
+    {
+      std::shared_ptr<Track> track = application->tracks.get(sp_link_as_track(link));
+      loadSet.tracks.push_back(track);
+      return NodeTrack::fromTrack(track);
+    }
+    case SP_LINKTYPE_ALBUM:
+    {
+      std::shared_ptr<Album> album = application->albums.get(sp_link_as_album(link));
+      loadSet.albums.push_back(album);
+      return NodeAlbum::fromAlbum(album);
+    }
+    case SP_LINKTYPE_ARTIST:
+    {
+      std::shared_ptr<Artist> artist = application->artists.get(sp_link_as_artist(link));
+      loadSet.artists.push_back(artist);
+      return NodeArtist::fromArtist(artist);
+    }
+    case SP_LINKTYPE_PLAYLIST:
+    case SP_LINKTYPE_STARRED:
+    {
+      sp_playlist* spPlaylist = sp_playlist_create(application->session, link);
+      if(spPlaylist == nullptr) {
+        return Handle<Value>();
+      }
+      //Playlists outside of the container have no id.
+      std::shared_ptr<Playlist> playlist = application->playlists.get(spPlaylist, -1);
+      sp_playlist_release(spPlaylist);
+      playlist->addCallbacks();
+      loadSet.playlists.push_back(playlist);
+      return NodePlaylist::fromPlaylist(playlist);
+    }
+    default:
+      return Handle<Value>();
+  }
+}
+
 Handle<Value> NodeSpotify::createFromLink(const Arguments& args) {
   HandleScope scope;
   Handle<Value> out;
   String::Utf8Value linkToParse(args[0]->ToString());
   sp_link* parsedLink = sp_link_create_from_string(*linkToParse);
   if(parsedLink != nullptr) {
-    sp_linktype linkType = sp_link_type(parsedLink);
-    switch(linkType) {
-      case SP_LINKTYPE_TRACK:
-      {
-        sp_track* track = sp_link_as_track(parsedLink);
-        NodeTrack* nodeTrack = new NodeTrack(std::make_shared<Track>(track));
-        out = nodeTrack->getV8Object();
-        break;
-      }
-      case SP_LINKTYPE_ALBUM:
-      {
-        sp_album* album = sp_link_as_album(parsedLink);
-        NodeAlbum* nodeAlbum = new NodeAlbum(std::make_shared<Album>(album));
-        out = nodeAlbum->getV8Object();
-        break;
-      }
-      case SP_LINKTYPE_ARTIST:
-      {
-        sp_artist* artist = sp_link_as_artist(parsedLink);
-        NodeArtist* nodeArtist = new NodeArtist(std::make_shared<Artist>(artist));
-        out = nodeArtist->getV8Object();
-        break;
-      }
-      case SP_LINKTYPE_SEARCH:
-        out = Undefined();
-        break;
-      case SP_LINKTYPE_PLAYLIST:
-        out = Undefined();
-        break;
-      default:
-        out = Undefined();
-    }
-  } else {
+    LoadSet loadSet;
+    out = objectFromLink(parsedLink, loadSet);
+    sp_link_release(parsedLink);
+  }
+  if(out.IsEmpty()) {
     out = Undefined();
   }
-  sp_link_release(parsedLink);
   return scope.Close(out);
 }
 
+/**
+ * Resolves many links in one call: spotify.createFromLinks(links, [options,] [callback]).
+ * Returns {objects, errors} where objects has one entry per link (null if it failed) and errors has {index, link, message}
+ * per failed link. Identical links resolve to the same object. With options.waitForLoad the result is passed to the
+ * callback (or promise) once all objects are loaded or options.timeout (in ms) ran out.
+ **/
+Handle<Value> NodeSpotify::createFromLinks(const Arguments& args) {
+  HandleScope scope;
+  if(!args[0]->IsArray()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("createFromLinks expects an array of links"))));
+  }
+  Handle<Array> links = Handle<Array>::Cast(args[0]);
+  bool hasOptions = args[1]->IsObject() && !args[1]->IsFunction();
+  bool waitForLoad = false;
+  int timeout = 0;
+  if(hasOptions) {
+    Handle<Object> options = args[1]->ToObject();
+    waitForLoad = options->Get(Symbols::waitForLoad)->BooleanValue();
+    Handle<Value> timeoutValue = options->Get(Symbols::timeout);
+    timeout = timeoutValue->IsNumber() ? timeoutValue->IntegerValue() : 0;
+  }
+
+  int length = links->Length();
+  Local<Array> objects = Array::New(length);
+  Local<Array> errors = Array::New();
+  std::map<std::string, Handle<Value>> resolved;
+  LoadSet loadSet;
+  for(int i = 0; i < length; i++) {
+    String::Utf8Value linkString(links->Get(i)->ToString());
+    std::string link(*linkString);
+    auto it = resolved.find(link);
+    if(it != resolved.end()) {
+      objects->Set(i, it->second);
+      continue;
+    }
+    Handle<Value> object;
+    const char* message = "Could not parse link";
+    sp_link* parsedLink = sp_link_create_from_string(link.c_str());
+    if(parsedLink != nullptr) {
+      object = objectFromLink(parsedLink, loadSet);
+      sp_link_release(parsedLink);
+      message = "Unsupported link type";
+    }
+    if(object.IsEmpty()) {
+      Local<Object> error = Object::New();
+      error->Set(Symbols::index, Integer::New(i));
+      error->Set(Symbols::link, String::New(link.c_str()));
+      error->Set(Symbols::message, String::New(message));
+      errors->Set(errors->Length(), error);
+      object = Null();
+    }
+    resolved[link] = object;
+    objects->Set(i, object);
+  }
+  Local<Object> result = Object::New();
+  result->Set(Symbols::objects, objects);
+  result->Set(Symbols::errors, errors);
+
+  if(!waitForLoad) {
+    return scope.Close(result);
+  }
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(hasOptions ? args[2] : args[1], callback);
+  if(callback.IsEmpty()) {
+    return scope.Close(promise);
+  }
+  Persistent<Function> persistentCallback = PersistentUtils::create(callback);
+  Persistent<Object> persistentResult = PersistentUtils::create<Object>(result);
+  application->metadataLoader.wait(loadSet, timeout, [persistentCallback, persistentResult](LoadResult loadResult) mutable {
+    HandleScope scope;
+    Handle<Value> argv[2] = {loadError(loadResult), persistentResult};
+    TryCatch tryCatch;
+    persistentCallback->Call(Context::GetCurrent()->Global(), 2, argv);
+    PersistentUtils::dispose(persistentCallback);
+    PersistentUtils::dispose(persistentResult);
+    if(tryCatch.HasCaught()) {
+      node::FatalException(tryCatch);
+    }
+    scope.Close(Undefined());
+  });
+  return scope.Close(promise);
+}
+
 Handle<Value> NodeSpotify::login(const Arguments& args) {
   HandleScope scope;
   NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
@@ -133,6 +334,18 @@ Handle<Value> NodeSpotify::login(const Arguments& args) {
   return scope.Close(Undefined());
 }
 
+Handle<Value> NodeSpotify::loginWithCredentialsBlob(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  if(args.Length() < 2 || !args[0]->IsString() || !args[1]->IsString()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Please provide a username and a credentials blob"))));
+  }
+  String::Utf8Value v8User(args[0]->ToString());
+  String::Utf8Value v8Blob(args[1]->ToString());
+  nodeSpotify->spotify->loginWithCredentialsBlob(std::string(*v8User), std::string(*v8Blob));
+  return scope.Close(Undefined());
+}
+
 Handle<Value> NodeSpotify::logout(const Arguments& args) {
   HandleScope scope;
   NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
@@ -140,11 +353,41 @@ Handle<Value> NodeSpotify::logout(const Arguments& args) {
   return scope.Close(Undefined());
 }
 
+/**
+ * ready(callback, [once]) registers a callback for when the user is logged in and the playlists are available.
+ * The callback is called only once unless once is false, then it is called after every login until offReady.
+ * If the login fails the callback (or the promise) gets the error, callbacks with once set to false only hear about successful logins.
+ * Without a callback it returns a promise.
+ **/
 Handle<Value> NodeSpotify::ready(const Arguments& args) {
   HandleScope scope;
-  Handle<Function> fun = Handle<Function>::Cast(args[0]);
-  Persistent<Function> p = Persistent<Function>::New(fun);
-  SessionCallbacks::loginCallback = p;
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(args[0], callback);
+  if(!callback.IsEmpty()) {
+    bool once = args[0]->IsFunction() && args[1]->IsBoolean() ? args[1]->BooleanValue() : true;
+    SessionCallbacks::addReadyCallback(callback, once);
+  }
+  return scope.Close(promise);
+}
+
+/**
+ * offReady(callback) removes a callback registered with ready, returns the number of removed callbacks.
+ **/
+Handle<Value> NodeSpotify::offReady(const Arguments& args) {
+  HandleScope scope;
+  if(!args[0]->IsFunction()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Please provide a function"))));
+  }
+  int removed = SessionCallbacks::removeReadyCallback(Handle<Function>::Cast(args[0]));
+  return scope.Close(Integer::New(removed));
+}
+
+Handle<Value> NodeSpotify::setPromiseFactory(const Arguments& args) {
+  HandleScope scope;
+  if(!args[0]->IsFunction()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("Please provide a function"))));
+  }
+  PromiseUtils::setFactory(Handle<Function>::Cast(args[0]));
   return scope.Close(Undefined());
 }
 
@@ -153,16 +396,67 @@ Handle<Value> NodeSpotify::getPlaylists(const Arguments& args) {
   std::vector<std::shared_ptr<Playlist>> playlists = application->playlistContainer->getPlaylists();
   Local<Array> nPlaylists = Array::New(playlists.size());
   for(int i = 0; i < (int)playlists.size(); i++) {
-    NodePlaylist* nodePlaylist = new NodePlaylist(playlists[i]);
-    nPlaylists->Set(Number::New(i), nodePlaylist->getV8Object());
+    nPlaylists->Set(Number::New(i), NodePlaylist::fromPlaylist(playlists[i]));
   }
   return scope.Close(nPlaylists);
 }
 
+/**
+ * The playlists with their folders: an array of playlists and folders {type: 'folder', id, name, children: [...]}.
+ * Built in one pass over the container, the folder start and end entries open and close the children arrays.
+ * Empty while no user is logged in.
+ **/
+Handle<Value> NodeSpotify::getPlaylistTree(const Arguments& args) {
+  HandleScope scope;
+  Local<Array> root = Array::New();
+  if(!application->playlistContainer) {
+    return scope.Close(root);
+  }
+  const std::vector<ContainerItem>& items = application->playlistContainer->getItems();
+  std::vector<Local<Array>> open(1, root);
+  for(auto it = items.begin(); it != items.end(); it++) {
+    Local<Array> children = open.back();
+    if(it->type == SP_PLAYLIST_TYPE_PLAYLIST) {
+      children->Set(children->Length(), NodePlaylist::fromPlaylist(it->playlist));
+    } else if(it->type == SP_PLAYLIST_TYPE_START_FOLDER) {
+      Local<Object> folder = Object::New();
+      Local<Array> folderChildren = Array::New();
+      folder->Set(Symbols::type, Symbols::folder);
+      folder->Set(Symbols::id, Integer::New(it->id));
+      folder->Set(Symbols::name, String::New(it->folderName.c_str()));
+      folder->Set(Symbols::children, folderChildren);
+      children->Set(children->Length(), folder);
+      open.push_back(folderChildren);
+    } else if(it->type == SP_PLAYLIST_TYPE_END_FOLDER && open.size() > 1) {
+      open.pop_back();
+    }
+  }
+  return scope.Close(root);
+}
+
 Handle<Value> NodeSpotify::getStarred(const Arguments& args) {
   HandleScope scope;
-  NodePlaylist* starredPlaylist = new NodePlaylist(application->playlistContainer->starredPlaylist);
-  return scope.Close(starredPlaylist->getV8Object());
+  return scope.Close(NodePlaylist::fromPlaylist(application->playlistContainer->starredPlaylist));
+}
+
+/**
+ * spotify.setStarred(tracks, starred) stars or unstars all tracks at once.
+ **/
+Handle<Value> NodeSpotify::setStarred(const Arguments& args) {
+  HandleScope scope;
+  std::vector<std::shared_ptr<Track>> tracks;
+  if(!NodeTrack::toTracks(args[0], tracks)) {
+    return scope.Close(ThrowException(Exception::Error(String::New("setStarred expects an array of tracks"))));
+  }
+  int applied;
+  sp_error error = Track::setStarred(tracks, args[1]->BooleanValue(), applied);
+  if(error != SP_ERROR_OK) {
+    std::string message = std::string(sp_error_message(error)) + " (" + std::to_string(applied) + " tracks were applied)";
+    Handle<Value> exception = Exception::Error(String::New(message.c_str()));
+    exception->ToObject()->Set(Symbols::applied, Integer::New(applied));
+    return scope.Close(ThrowException(exception));
+  }
+  return scope.Close(Undefined());
 }
 
 Handle<Value> NodeSpotify::getRememberedUser(Local<String> property, const AccessorInfo& info) {
@@ -171,15 +465,277 @@ Handle<Value> NodeSpotify::getRememberedUser(Local<String> property, const Acces
   return scope.Close(String::New(nodeSpotify->spotify->rememberedUser().c_str()));
 }
 
+Handle<Value> NodeSpotify::setCacheSize(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  int cacheSize = toCacheSize(args[0]);
+  if(cacheSize == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New(cacheSizeError))));
+  }
+  nodeSpotify->spotify->setCacheSize(cacheSize);
+  return scope.Close(Undefined());
+}
+
+Handle<Value> NodeSpotify::setPreferredBitrate(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  int bitrate = toBitrate(args[0]);
+  if(bitrate == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New(bitrateError))));
+  }
+  nodeSpotify->spotify->setPreferredBitrate(static_cast<sp_bitrate>(bitrate));
+  return scope.Close(Undefined());
+}
+
+Handle<Value> NodeSpotify::setPreferredOfflineBitrate(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  int bitrate = toBitrate(args[0]);
+  if(bitrate == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New(bitrateError))));
+  }
+  bool allowResync = args[1]->ToBoolean()->Value();
+  nodeSpotify->spotify->setPreferredOfflineBitrate(static_cast<sp_bitrate>(bitrate), allowResync);
+  return scope.Close(Undefined());
+}
+
+Handle<Value> NodeSpotify::setConnectionType(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  int connectionType = toConnectionType(args[0]);
+  if(connectionType == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New(connectionTypeError))));
+  }
+  nodeSpotify->spotify->setConnectionType(static_cast<sp_connection_type>(connectionType));
+  return scope.Close(Undefined());
+}
+
+Handle<Value> NodeSpotify::setConnectionRules(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  int connectionRules = toConnectionRules(args[0]);
+  if(connectionRules == -1) {
+    return scope.Close(ThrowException(Exception::Error(String::New(connectionRulesError))));
+  }
+  nodeSpotify->spotify->setConnectionRules(static_cast<sp_connection_rules>(connectionRules));
+  return scope.Close(Undefined());
+}
+
+/**
+ * spotify.getCacheUsage([callback]) calls back with the size of the libspotify cache on disk in bytes.
+ * The cache folder is read off the main thread, without a callback a promise is returned.
+ **/
+Handle<Value> NodeSpotify::getCacheUsage(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(args[0], callback);
+  if(callback.IsEmpty()) {
+    return scope.Close(promise);
+  }
+  Persistent<Function> persistentCallback = PersistentUtils::create(callback);
+  nodeSpotify->spotify->cacheUsage([persistentCallback](uint64_t size) mutable {
+    HandleScope scope;
+    Handle<Value> argv[2] = {Undefined(), Number::New(size)};
+    TryCatch tryCatch;
+    persistentCallback->Call(Context::GetCurrent()->Global(), 2, argv);
+    PersistentUtils::dispose(persistentCallback);
+    if(tryCatch.HasCaught()) {
+      node::FatalException(tryCatch);
+    }
+    scope.Close(Undefined());
+  });
+  return scope.Close(promise);
+}
+
+/**
+ * Returns the aggregated progress of the offline synchronisation.
+ * The offline_status_updated event passes the same object when it changes.
+ * Undefined while no user is logged in.
+ **/
+Handle<Value> NodeSpotify::getOfflineSyncStatus(const Arguments& args) {
+  HandleScope scope;
+  if(!application->playlistContainer) {
+    return scope.Close(Undefined());
+  }
+  return scope.Close(offlineSyncStatusToObject(application->playlistContainer->offlineSyncStatus()));
+}
+
+Handle<Object> NodeSpotify::offlineSyncStatusToObject(const OfflineSyncStatus& status) {
+  HandleScope scope;
+  Local<Object> out = Object::New();
+  out->Set(Symbols::syncing, Boolean::New(status.syncing));
+  out->Set(Symbols::queuedTracks, Integer::New(status.queuedTracks));
+  out->Set(Symbols::queuedBytes, Number::New(status.queuedBytes));
+  out->Set(Symbols::doneTracks, Integer::New(status.doneTracks));
+  out->Set(Symbols::doneBytes, Number::New(status.doneBytes));
+  out->Set(Symbols::copiedTracks, Integer::New(status.copiedTracks));
+  out->Set(Symbols::copiedBytes, Number::New(status.copiedBytes));
+  out->Set(Symbols::willNotCopyTracks, Integer::New(status.willNotCopyTracks));
+  out->Set(Symbols::errorTracks, Integer::New(status.errorTracks));
+  out->Set(Symbols::tracksToSync, Integer::New(status.tracksToSync));
+  out->Set(Symbols::offlinePlaylists, Integer::New(status.offlinePlaylists));
+  out->Set(Symbols::timeLeft, Integer::New(status.timeLeft));
+  return scope.Close(out);
+}
+
+/**
+ * Calls back when all given tracks, albums, artists and playlists are loaded: spotify.whenLoaded(objects, [timeout,] callback).
+ * The callback gets the objects or an error if the timeout (in ms) ran out. Returns a promise if there is no callback.
+ **/
+Handle<Value> NodeSpotify::whenLoaded(const Arguments& args) {
+  HandleScope scope;
+  if(!args[0]->IsArray()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("whenLoaded expects an array of spotify objects"))));
+  }
+  Handle<Array> objects = Handle<Array>::Cast(args[0]);
+  LoadSet loadSet;
+  for(int i = 0; i < (int)objects->Length(); i++) {
+    Handle<Value> value = objects->Get(i);
+    if(NodeTrack::isInstance(value)) {
+      loadSet.tracks.push_back(node::ObjectWrap::Unwrap<NodeTrack>(value->ToObject())->track);
+    } else if(NodeAlbum::isInstance(value)) {
+      loadSet.albums.push_back(node::ObjectWrap::Unwrap<NodeAlbum>(value->ToObject())->album);
+    } else if(NodeArtist::isInstance(value)) {
+      loadSet.artists.push_back(node::ObjectWrap::Unwrap<NodeArtist>(value->ToObject())->artist);
+    } else if(NodePlaylist::isInstance(value)) {
+      loadSet.playlists.push_back(node::ObjectWrap::Unwrap<NodePlaylist>(value->ToObject())->playlist);
+    } else {
+      return scope.Close(ThrowException(Exception::Error(String::New("whenLoaded only accepts tracks, albums, artists and playlists"))));
+    }
+  }
+  bool hasTimeout = args[1]->IsNumber();
+  int timeout = hasTimeout ? args[1]->IntegerValue() : 0;
+  Handle<Function> callback;
+  Handle<Value> promise = PromiseUtils::callbackOrPromise(hasTimeout ? args[2] : args[1], callback);
+  if(callback.IsEmpty()) {
+    return scope.Close(promise);
+  }
+  Persistent<Function> persistentCallback = PersistentUtils::create(callback);
+  Persistent<Array> persistentObjects = PersistentUtils::create(objects);
+  application->metadataLoader.wait(loadSet, timeout, [persistentCallback, persistentObjects](LoadResult loadResult) mutable {
+    HandleScope scope;
+    Handle<Value> argv[2] = {loadError(loadResult), Undefined()};
+    if(loadResult == LOAD_DONE) {
+      argv[1] = persistentObjects;
+    }
+    //every waiter has its own TryCatch, an exception must not keep the others from being called
+    TryCatch tryCatch;
+    persistentCallback->Call(Context::GetCurrent()->Global(), 2, argv);
+    PersistentUtils::dispose(persistentCallback);
+    PersistentUtils::dispose(persistentObjects);
+    if(tryCatch.HasCaught()) {
+      node::FatalException(tryCatch);
+    }
+    scope.Close(Undefined());
+  });
+  return scope.Close(promise);
+}
+
+/**
+ * Returns the number of persistent handles held for callbacks and pending results, for finding leaks.
+ **/
+Handle<Value> NodeSpotify::getLiveHandleCount(const Arguments& args) {
+  HandleScope scope;
+  return scope.Close(Integer::New(PersistentUtils::liveHandles));
+}
+
+static const char* requestTypeNames[REQUEST_TYPE_COUNT] = { "search", "albumBrowse", "artistBrowse" };
+
+/**
+ * Returns queue depths, in-flight counts and totals of the request scheduler per request type.
+ **/
+Handle<Value> NodeSpotify::getRequestStats(const Arguments& args) {
+  HandleScope scope;
+  Local<Object> out = Object::New();
+  for(int type = 0; type < REQUEST_TYPE_COUNT; type++) {
+    RequestStats stats = application->requestScheduler.stats(static_cast<RequestType>(type));
+    Local<Object> typeStats = Object::New();
+    typeStats->Set(Symbols::queuedInteractive, Integer::New(stats.queued[PRIORITY_INTERACTIVE]));
+    typeStats->Set(Symbols::queuedBackground, Integer::New(stats.queued[PRIORITY_BACKGROUND]));
+    typeStats->Set(Symbols::inFlight, Integer::New(stats.inFlight));
+    typeStats->Set(Symbols::limit, Integer::New(stats.limit));
+    typeStats->Set(Symbols::started, Number::New(stats.started));
+    typeStats->Set(Symbols::completed, Number::New(stats.completed));
+    typeStats->Set(Symbols::timedOut, Number::New(stats.timedOut));
+    out->Set(String::NewSymbol(requestTypeNames[type]), typeStats);
+  }
+  return scope.Close(out);
+}
+
+/**
+ * Sets the maximum number of running requests, e.g. spotify.setRequestLimits({search: 2, albumBrowse: 10}).
+ **/
+Handle<Value> NodeSpotify::setRequestLimits(const Arguments& args) {
+  HandleScope scope;
+  if(args.Length() < 1 || !args[0]->IsObject()) {
+    return scope.Close(ThrowException(Exception::Error(String::New("setRequestLimits expects an object"))));
+  }
+  Handle<Object> limits = args[0]->ToObject();
+  for(int type = 0; type < REQUEST_TYPE_COUNT; type++) {
+    Handle<Value> limit = limits->Get(String::NewSymbol(requestTypeNames[type]));
+    if(limit->IsUndefined()) {
+      continue;
+    }
+    if(!limit->IsNumber() || limit->IntegerValue() < 1) {
+      return scope.Close(ThrowException(Exception::Error(String::New("Request limits must be at least 1"))));
+    }
+    application->requestScheduler.setLimit(static_cast<RequestType>(type), limit->IntegerValue());
+  }
+  return scope.Close(Undefined());
+}
+
+/**
+ * Returns the duration of each step until the session is ready in milliseconds.
+ * Steps that have not been completed yet are null.
+ **/
+static Handle<Value> durationBetween(uint64_t start, uint64_t end) {
+  if(start == 0 || end == 0) {
+    return Null();
+  }
+  return Number::New((end - start) / 1e6);
+}
+
+Handle<Value> NodeSpotify::getTimeToReady(const Arguments& args) {
+  HandleScope scope;
+  NodeSpotify* nodeSpotify = node::ObjectWrap::Unwrap<NodeSpotify>(args.This());
+  TimeToReady& timeToReady = nodeSpotify->spotify->timeToReady;
+  Local<Object> out = Object::New();
+  out->Set(Symbols::sessionCreate, durationBetween(timeToReady.sessionCreateStart, timeToReady.sessionCreated));
+  out->Set(Symbols::login, durationBetween(timeToReady.loginStart, timeToReady.loggedIn));
+  out->Set(Symbols::playlistContainer, durationBetween(timeToReady.loggedIn, timeToReady.playlistContainerLoaded));
+  out->Set(Symbols::playlists, durationBetween(timeToReady.playlistContainerLoaded, timeToReady.playlistsLoaded));
+  out->Set(Symbols::total, durationBetween(timeToReady.loginStart, timeToReady.playlistsLoaded));
+  return scope.Close(out);
+}
+
 void NodeSpotify::init() {
   HandleScope scope;
-  Handle<FunctionTemplate> constructorTemplate = NodeWrapped::init("Spotify");
+  Handle<FunctionTemplate> constructorTemplate = NodeWrappedWithCallbacks::init("Spotify");
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "login", login);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "loginWithCredentialsBlob", loginWithCredentialsBlob);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "logout", logout);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getPlaylists", getPlaylists);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getPlaylistTree", getPlaylistTree);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getStarred", getStarred);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setStarred", setStarred);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "ready", ready);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "offReady", offReady);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setPromiseFactory", setPromiseFactory);
   NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "createFromLink", createFromLink);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "createFromLinks", createFromLinks);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getTimeToReady", getTimeToReady);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setCacheSize", setCacheSize);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setPreferredBitrate", setPreferredBitrate);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setPreferredOfflineBitrate", setPreferredOfflineBitrate);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setConnectionType", setConnectionType);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setConnectionRules", setConnectionRules);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getCacheUsage", getCacheUsage);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getOfflineSyncStatus", getOfflineSyncStatus);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getRequestStats", getRequestStats);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getLiveHandleCount", getLiveHandleCount);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "whenLoaded", whenLoaded);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "setRequestLimits", setRequestLimits);
   constructorTemplate->InstanceTemplate()->SetAccessor(String::NewSymbol("rememberedUser"), getRememberedUser, emptySetter);
   constructor = Persistent<Function>::New(constructorTemplate->GetFunction());
   scope.Close(Undefined());
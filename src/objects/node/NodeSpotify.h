@@ -25,23 +25,44 @@ THE SOFTWARE.
 #ifndef _NODE_SPOTIFY_H
 #define _NODE_SPOTIFY_H
 
-#include "NodeWrapped.h"
+#include "NodeWrappedWithCallbacks.h"
 #include "../spotify/Spotify.h"
 #include <v8.h>
 
 using namespace v8;
 
-class NodeSpotify : public NodeWrapped<NodeSpotify> {
+struct OfflineSyncStatus;
+
+class NodeSpotify : public NodeWrappedWithCallbacks<NodeSpotify> {
 public:
   NodeSpotify(Handle<Object> option);
   ~NodeSpotify() {};
   static Handle<Value> login(const Arguments& args);
+  static Handle<Value> loginWithCredentialsBlob(const Arguments& args);
   static Handle<Value> logout(const Arguments& args);
   static Handle<Value> ready(const Arguments& args);
+  static Handle<Value> offReady(const Arguments& args);
+  static Handle<Value> setPromiseFactory(const Arguments& args);
   static Handle<Value> getPlaylists(const Arguments& args);
+  static Handle<Value> getPlaylistTree(const Arguments& args);
   static Handle<Value> getStarred(const Arguments& args);
+  static Handle<Value> setStarred(const Arguments& args);
   static Handle<Value> getRememberedUser(Local<String> property, const AccessorInfo& info);
   static Handle<Value> createFromLink(const Arguments& args);
+  static Handle<Value> createFromLinks(const Arguments& args);
+  static Handle<Value> getTimeToReady(const Arguments& args);
+  static Handle<Value> setCacheSize(const Arguments& args);
+  static Handle<Value> setPreferredBitrate(const Arguments& args);
+  static Handle<Value> setPreferredOfflineBitrate(const Arguments& args);
+  static Handle<Value> setConnectionType(const Arguments& args);
+  static Handle<Value> setConnectionRules(const Arguments& args);
+  static Handle<Value> getCacheUsage(const Arguments& args);
+  static Handle<Value> getOfflineSyncStatus(const Arguments& args);
+  static Handle<Object> offlineSyncStatusToObject(const OfflineSyncStatus& status);
+  static Handle<Value> getRequestStats(const Arguments& args);
+  static Handle<Value> getLiveHandleCount(const Arguments& args);
+  static Handle<Value> whenLoaded(const Arguments& args);
+  static Handle<Value> setRequestLimits(const Arguments& args);
   static void init();
 private:
   std::unique_ptr<Spotify> spotify;
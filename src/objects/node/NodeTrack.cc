@@ -25,6 +25,45 @@ THE SOFTWARE.
 #include "NodeTrack.h"
 #include "NodeArtist.h"
 #include "NodeAlbum.h"
+#include "NodeList.h"
+#include "../../Application.h"
+#include "../../utils/TypedArrayUtils.h"
+#include "../../utils/Symbols.h"
+
+#include <string.h>
+#include <unordered_map>
+
+extern Application* application;
+
+/**
+ * Returns the Javascript object of the track. While it is not garbage collected the same object is returned.
+ **/
+Handle<Object> NodeTrack::fromTrack(std::shared_ptr<Track> track) {
+  if(track->nodeObject != nullptr) {
+    return static_cast<NodeTrack*>(track->nodeObject)->getV8Object();
+  }
+  NodeTrack* nodeTrack = new NodeTrack(track);
+  return nodeTrack->getV8Object();
+}
+
+/**
+ * Reads an array of Javascript tracks. Returns false if value is no array or contains something else than tracks.
+ **/
+bool NodeTrack::toTracks(Handle<Value> value, std::vector<std::shared_ptr<Track>>& tracks) {
+  if(!value->IsArray()) {
+    return false;
+  }
+  Handle<Array> nodeTracks = Handle<Array>::Cast(value);
+  tracks.resize(nodeTracks->Length());
+  for(int i = 0; i < (int)tracks.size(); i++) {
+    Handle<Value> nodeTrack = nodeTracks->Get(i);
+    if(!isInstance(nodeTrack)) {
+      return false;
+    }
+    tracks[i] = node::ObjectWrap::Unwrap<NodeTrack>(nodeTrack->ToObject())->track;
+  }
+  return true;
+}
 
 Handle<Value> NodeTrack::getName(Local<String> property, const AccessorInfo& info) {
   NodeTrack* nodeTrack = node::ObjectWrap::Unwrap<NodeTrack>(info.Holder());
@@ -49,10 +88,10 @@ Handle<Value> NodeTrack::getPopularity(Local<String> property, const AccessorInf
 Handle<Value> NodeTrack::getArtists(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeTrack* nodeTrack = node::ObjectWrap::Unwrap<NodeTrack>(info.Holder());
-  Local<Array> jsArtists = Array::New(nodeTrack->track->artists().size());
-  for(int i = 0; i < (int)nodeTrack->track->artists().size(); i++) {
-    NodeArtist* nodeArtist = new NodeArtist(nodeTrack->track->artists()[i]);
-    jsArtists->Set(Number::New(i), nodeArtist->getV8Object() );
+  std::vector<std::shared_ptr<Artist>> artists = nodeTrack->track->artists();
+  Local<Array> jsArtists = Array::New(artists.size());
+  for(int i = 0; i < (int)artists.size(); i++) {
+    jsArtists->Set(Number::New(i), NodeArtist::fromArtist(artists[i]));
   }
   return scope.Close(jsArtists);
 }
@@ -60,8 +99,7 @@ Handle<Value> NodeTrack::getArtists(Local<String> property, const AccessorInfo&
 Handle<Value> NodeTrack::getAlbum(Local<String> property, const AccessorInfo& info) {
   HandleScope scope;
   NodeTrack* nodeTrack = node::ObjectWrap::Unwrap<NodeTrack>(info.Holder());
-  NodeAlbum* nodeAlbum = new NodeAlbum(nodeTrack->track->album());
-  return scope.Close(nodeAlbum->getV8Object());
+  return scope.Close(NodeAlbum::fromAlbum(nodeTrack->track->album()));
 }
 
 Handle<Value> NodeTrack::getStarred(Local<String> property, const AccessorInfo& info) {
@@ -76,6 +114,118 @@ void NodeTrack::setStarred(Local<String> property, Local<Value> value, const Acc
   scope.Close(Undefined());
 }
 
+static const struct {
+  const char* name;
+  TrackColumn column;
+} columnNames[] = {
+  { "duration", COLUMN_DURATION },
+  { "popularity", COLUMN_POPULARITY },
+  { "starred", COLUMN_STARRED },
+  { "createTime", COLUMN_CREATE_TIME },
+  { "name", COLUMN_NAME },
+  { "link", COLUMN_LINK },
+  { "artist", COLUMN_ARTIST },
+  { "album", COLUMN_ALBUM }
+};
+static const int numColumnNames = sizeof(columnNames) / sizeof(columnNames[0]);
+
+/**
+ * Converts an array of field names ('name', 'duration', ...) to a combination of TrackColumn values.
+ * Anything but an array selects all fields, -1 is returned for unknown names.
+ **/
+int NodeTrack::parseFields(Handle<Value> fields) {
+  int columns = 0;
+  if(!fields->IsArray()) {
+    for(int j = 0; j < numColumnNames; j++) {
+      columns |= columnNames[j].column;
+    }
+    return columns;
+  }
+  Handle<Array> fieldArray = Handle<Array>::Cast(fields);
+  for(int i = 0; i < (int)fieldArray->Length(); i++) {
+    String::Utf8Value field(fieldArray->Get(i)->ToString());
+    int j = 0;
+    while(j < numColumnNames && strcmp(columnNames[j].name, *field) != 0) {
+      j++;
+    }
+    if(j == numColumnNames) {
+      return -1;
+    }
+    columns |= columnNames[j].column;
+  }
+  return columns;
+}
+
+/**
+ * Returns the artists of all tracks in a track list: {artists, offsets, indices}. Every artist is in artists once.
+ * The artists of track i are artists[indices[j]] for offsets[i] <= j < offsets[i + 1]. Tracks that are not loaded have none.
+ **/
+Handle<Value> NodeTrack::getArtistsBulk(const Arguments& args) {
+  HandleScope scope;
+  const std::vector<std::shared_ptr<Track>>& tracks = node::ObjectWrap::Unwrap<NodeList<Track>>(args.This())->getItems();
+  std::vector<std::shared_ptr<Artist>> artists;
+  std::unordered_map<sp_artist*, uint32_t> artistIndices;
+  std::vector<uint32_t> offsets(tracks.size() + 1);
+  std::vector<uint32_t> indices;
+  for(int i = 0; i < (int)tracks.size(); i++) {
+    offsets[i] = indices.size();
+    Track::Snapshot* metadata = tracks[i]->loadSnapshot();
+    if(metadata == nullptr) {
+      continue;
+    }
+    for(sp_artist* spArtist : metadata->artists) {
+      auto it = artistIndices.find(spArtist);
+      if(it == artistIndices.end()) {
+        it = artistIndices.insert(std::make_pair(spArtist, (uint32_t)artists.size())).first;
+        artists.push_back(application->artists.get(spArtist));
+      }
+      indices.push_back(it->second);
+    }
+  }
+  offsets[tracks.size()] = indices.size();
+  Local<Object> out = Object::New();
+  out->Set(Symbols::artists, NodeList<Artist>::fromVector(artists));
+  out->Set(Symbols::offsets, TypedArrayUtils::fromVector(offsets));
+  out->Set(Symbols::indices, TypedArrayUtils::fromVector(indices));
+  return scope.Close(out);
+}
+
+/**
+ * Returns the albums of all tracks in a track list: {albums, indices}. Every album is in albums once,
+ * the album of track i is albums[indices[i]] or -1 if the track is not loaded.
+ **/
+Handle<Value> NodeTrack::getAlbumsBulk(const Arguments& args) {
+  HandleScope scope;
+  const std::vector<std::shared_ptr<Track>>& tracks = node::ObjectWrap::Unwrap<NodeList<Track>>(args.This())->getItems();
+  std::vector<std::shared_ptr<Album>> albums;
+  std::unordered_map<sp_album*, int32_t> albumIndices;
+  std::vector<int32_t> indices(tracks.size(), -1);
+  for(int i = 0; i < (int)tracks.size(); i++) {
+    Track::Snapshot* metadata = tracks[i]->loadSnapshot();
+    if(metadata == nullptr || metadata->album == nullptr) {
+      continue;
+    }
+    auto it = albumIndices.find(metadata->album);
+    if(it == albumIndices.end()) {
+      it = albumIndices.insert(std::make_pair(metadata->album, (int32_t)albums.size())).first;
+      albums.push_back(application->albums.get(metadata->album));
+    }
+    indices[i] = it->second;
+  }
+  Local<Object> out = Object::New();
+  out->Set(Symbols::albums, NodeList<Album>::fromVector(albums));
+  out->Set(Symbols::indices, TypedArrayUtils::fromVector(indices));
+  return scope.Close(out);
+}
+
+/**
+ * Adds the bulk relation methods to track lists.
+ **/
+void NodeTrack::initTrackList(Handle<FunctionTemplate> constructorTemplate) {
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getArtistsBulk", getArtistsBulk);
+  NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "getAlbumsBulk", getAlbumsBulk);
+}
+
 void NodeTrack::init() {
   HandleScope scope;
   Handle<FunctionTemplate> constructorTemplate = NodeWrapped::init("Track");
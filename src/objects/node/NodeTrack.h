@@ -29,15 +29,26 @@ THE SOFTWARE.
 
 #include "NodeWrapped.h"
 #include "../spotify/Track.h"
+#include "../spotify/TrackColumns.h"
 
 using namespace v8;
 
 class NodeTrack : public NodeWrapped<NodeTrack> {
 friend class NodePlayer;
+friend class NodeSpotify;
 private:
   std::shared_ptr<Track> track;
 public:
-  NodeTrack(std::shared_ptr<Track> _track) : track(_track) {};
+  NodeTrack(std::shared_ptr<Track> _track) : track(_track) {
+    track->nodeObject = this;
+  };
+  ~NodeTrack() {
+    if(track->nodeObject == this) {
+      track->nodeObject = nullptr;
+    }
+  }
+  static Handle<Object> fromTrack(std::shared_ptr<Track> track);
+  static bool toTracks(Handle<Value> value, std::vector<std::shared_ptr<Track>>& tracks);
   static Handle<Value> getName(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getLink(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getArtists(Local<String> property, const AccessorInfo& info);
@@ -46,6 +57,10 @@ public:
   static Handle<Value> getStarred(Local<String> property, const AccessorInfo& info);
   static Handle<Value> getPopularity(Local<String> property, const AccessorInfo& info);
   static void setStarred(Local<String> property, Local<Value> value, const AccessorInfo& info);
+  static int parseFields(Handle<Value> fields);
+  static Handle<Value> getArtistsBulk(const Arguments& args);
+  static Handle<Value> getAlbumsBulk(const Arguments& args);
+  static void initTrackList(Handle<FunctionTemplate> constructorTemplate);
   static void init();
 };
 
@@ -51,6 +51,14 @@ public:
     }
     return handle_;
   }
+
+  /**
+   * True if value was created by the constructor of T, only then it can be unwrapped as T.
+   * This replaces dynamic_cast, node modules are compiled without RTTI.
+   **/
+  static bool isInstance(v8::Handle<v8::Value> value) {
+    return !functionTemplate.IsEmpty() && functionTemplate->HasInstance(value);
+  }
 protected:
   /**
    * A setter that does nothing which is useful for defining properties that should be read only
@@ -58,6 +66,7 @@ protected:
   static void emptySetter(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::AccessorInfo& info) {};
 
   static v8::Persistent<v8::Function> constructor;
+  static v8::Persistent<v8::FunctionTemplate> functionTemplate;
 
   /**
    * Basic init method for a wrapped node object.
@@ -66,10 +75,15 @@ protected:
     v8::Local<v8::FunctionTemplate> constructorTemplate = v8::FunctionTemplate::New();
     constructorTemplate->SetClassName(v8::String::NewSymbol(className));
     constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
+    if(!functionTemplate.IsEmpty()) {
+      functionTemplate.Dispose();
+    }
+    functionTemplate = v8::Persistent<v8::FunctionTemplate>::New(constructorTemplate);
     return constructorTemplate;
   }
 };
 
 //The constructor must be static per template instance not fro all NodeWrapped subclasses.
 template <class T> v8::Persistent<v8::Function> NodeWrapped<T>::constructor;
+template <class T> v8::Persistent<v8::FunctionTemplate> NodeWrapped<T>::functionTemplate;
 #endif
@@ -27,113 +27,167 @@ THE SOFTWARE.
 
 #include "NodeWrapped.h"
 #include "V8Callable.h"
+#include "Listeners.h"
+#include "EventBatch.h"
 
 #include <v8.h>
 #include <node.h>
 #include <string>
 
 #include "../../Application.h"
+#include "../../events.h"
+#include "../../utils/Symbols.h"
 
 extern Application* application;
 
 /**
  * This base class is for javascript objects that should provide callbacks.
- * The callbacks can be set/unset from javascript via on(name, function) / off(name)
- * There is also the possibility to attach static callbacks, i.e. callbacks that are
+ * Any number of listeners can be added from javascript via on(name, function) / once(name, function)
+ * and removed via off(name, function), off(name) removes all listeners of an event.
+ * There is also the possibility to attach static listeners, i.e. listeners that are
  * the same for all instances of a subclass.
  *
- * The callbacks can be called from C++ via the call(name) method. First instance callbacks
- * then static callbacks will be searched for a callback function. To assure callbacks are called
+ * The listeners can be called from C++ via the call(event) method. They are called in the order they were added,
+ * static listeners are only called for objects that have no listeners for the event. To assure callbacks are called
  * from within the node.js thread libuv is used to send an event to the main loop.
  * The function to handle these events is in node-spotify.cc
+ *
+ * Events that fire while libspotify processes its events are collected by EventBatch and delivered together afterwards.
+ * on(name, function, {batch: true}) adds a listener that gets the payloads of such a batch as one array.
+ *
+ * Event names are only resolved to their id (see events.h) in on/once/off, listeners are stored in arrays indexed by the id.
  **/
 template<class T>
 class NodeWrappedWithCallbacks : public NodeWrapped<T>, public V8Callable {
 template <class S> friend class StaticCallbackSetter;
 public:
   /**
-   * To set a callback from within C++.
+   * To add a listener from within C++.
   **/
-  void on(std::string name, v8::Handle<v8::Function> callback) {
-    v8::HandleScope scope;
-    this->callbacks[name] = v8::Persistent<v8::Function>::New(callback);
-    scope.Close(v8::Undefined());
+  void on(Event event, v8::Handle<v8::Function> callback) {
+    this->listeners[event].add(callback, false);
   }
 
   /**
-   * Save a Javascript callback under a certain name.
-   * This method will be called from Javascript.
+   * Add a Javascript listener for an event.
+   * This method will be called from Javascript. Names that are no event are ignored, they would never be called.
    **/
   static v8::Handle<v8::Value> on(const v8::Arguments& args) {
     v8::HandleScope scope;
     T* object = node::ObjectWrap::Unwrap<T>(args.This());
-    v8::String::Utf8Value callbackName(args[0]->ToString());
-    v8::Handle<v8::Function> fun = v8::Handle<v8::Function>::Cast(args[1]);
-    object->callbacks[*callbackName] = v8::Persistent<v8::Function>::New(fun);
-    return scope.Close(v8::Undefined());
+    add(object->listeners, args, false);
+    return scope.Close(args.This());
+  }
+
+  /**
+   * Add a Javascript listener that is removed after the event fired once.
+   **/
+  static v8::Handle<v8::Value> once(const v8::Arguments& args) {
+    v8::HandleScope scope;
+    T* object = node::ObjectWrap::Unwrap<T>(args.This());
+    add(object->listeners, args, true);
+    return scope.Close(args.This());
   }
 
   /**
-  * Deletes all callbacks that are saved under a name.
+  * Removes a listener by identity, or all listeners of an event if no function is given.
+  * Returns the number of removed listeners.
   **/
   static v8::Handle<v8::Value> off(const v8::Arguments& args) {
     v8::HandleScope scope;
     T* object = node::ObjectWrap::Unwrap<T>(args.This());
-    v8::String::Utf8Value callbackName(args[0]->ToString());
-    int deleted = object->callbacks.erase(*callbackName);
-    return scope.Close(v8::Integer::New(deleted));
+    return scope.Close(v8::Integer::New(remove(object->listeners, args)));
   }
 
-  void call(std::string name, v8::Handle<v8::Value> value) {
-    std::map< std::string, v8::Persistent<v8::Function> >::iterator it;
-    it = callbacks.find(name);
-
-    v8::Handle<v8::Function> callback;
+  /**
+   * Registers a callback that is called only the next time the event fires and is then removed.
+   * Any number of callbacks can wait for the same event, e.g. for a browse that is already running.
+   **/
+  void once(Event event, v8::Handle<v8::Function> callback) {
+    this->listeners[event].add(callback, true);
+  }
 
-    //Check if a callback for the given name was found in this object
-    if(it != callbacks.end()) {
-      //Get the adress of the callback function and send it to the node thread
-      //This needs to be the adress from the map element, otherwise we would pass the adress of a local and it fails on the node side.
-      callback = it->second;
+  void call(Event event, v8::Handle<v8::Value> error, v8::Handle<v8::Value> value) {
+    if(EventBatch::isActive()) {
+      EventBatch::add(this, this->getV8Object(), event, error, value);
+    } else if(!listeners[event].empty()) {
+      listeners[event].call(error, value);
     } else {
-      //search static callbacks
-      it = staticCallbacks.find(name);
-      if(it != staticCallbacks.end()) {
-        callback = it->second;
-      }
+      staticListeners[event].call(error, value);
     }
+  }
 
-    if(!callback.IsEmpty() && callback->IsCallable()) {
-      unsigned int argc = 2;
-      v8::Handle<v8::Value> argv[2];
-      //TODO: atm error is constantly undefined.
-      argv[0] = v8::Undefined();
-      argv[1] = value;
-      callback->Call(v8::Context::GetCurrent()->Global(), argc, argv);
-    }
+  void call(Event event, v8::Handle<v8::Value> value) {
+    call(event, v8::Undefined(), value);
   }
 
   /**
-   * Call a Javascript callback by name. The callback will be executed in the nodeJS thread.
-   * First, object wide callbacks will be searched, then, class wide callbacks.
-   * If no callback is found, nothing happens.
+   * Call the Javascript listeners of an event. The listeners will be executed in the nodeJS thread.
+   * If the object has no listeners for the event, the class wide listeners are called.
+   * If no listener is found, nothing happens.
    **/
-  void call(std::string name)  {
-    call(name, this->getV8Object());
+  void call(Event event)  {
+    call(event, this->getV8Object());
+  }
+
+  /**
+   * Call the listeners for event with an Error as the first argument.
+   **/
+  void callError(Event event, std::string message) {
+    v8::HandleScope scope;
+    call(event, v8::Exception::Error(v8::String::New(message.c_str())), this->getV8Object());
+    scope.Close(v8::Undefined());
+  }
+
+  Listeners& getListeners(Event event) {
+    return listeners[event];
+  }
+
+  void ref() {
+    this->Ref();
+  }
+
+  void unref() {
+    this->Unref();
+  }
+
+  Listeners& getStaticListeners(Event event) {
+    return staticListeners[event];
   }
 protected:
   static v8::Handle<v8::FunctionTemplate> init(const char* className) {
     v8::Handle<v8::FunctionTemplate> constructorTemplate = NodeWrapped<T>::init(className);
     NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "on", on);
+    NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "once", once);
     NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "off", off);
     return constructorTemplate;
   }
 private:
-  std::map<std::string, v8::Persistent<v8::Function>> callbacks;
-  static std::map<std::string, v8::Persistent<v8::Function>> staticCallbacks;
+  static void add(Listeners* listeners, const v8::Arguments& args, bool once) {
+    int event = Symbols::eventId(args[0]);
+    if(event != -1 && args[1]->IsFunction()) {
+      bool batch = args[2]->IsObject() && args[2]->ToObject()->Get(Symbols::batch)->BooleanValue();
+      listeners[event].add(v8::Handle<v8::Function>::Cast(args[1]), once, batch);
+    }
+  }
+
+  static int remove(Listeners* listeners, const v8::Arguments& args) {
+    int event = Symbols::eventId(args[0]);
+    if(event == -1) {
+      return 0;
+    } else if(args.Length() < 2 || args[1]->IsUndefined()) {
+      return listeners[event].removeAll();
+    } else {
+      return listeners[event].remove(args[1]);
+    }
+  }
+
+  //Disposed with the object when the Javascript object was garbage collected, the listeners can't be called anymore.
+  Listeners listeners[EVENT_COUNT];
+  static Listeners staticListeners[EVENT_COUNT];
 };
 
 //This field should be static per template, not for all NodeWrappedWithCallbacks subclasses.
-template <class T> std::map<std::string, v8::Persistent<v8::Function>> NodeWrappedWithCallbacks<T>::staticCallbacks;
+template <class T> Listeners NodeWrappedWithCallbacks<T>::staticListeners[EVENT_COUNT];
 
-#endif
\ No newline at end of file
+#endif
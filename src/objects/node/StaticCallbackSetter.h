@@ -27,15 +27,25 @@ THE SOFTWARE.
 
 #include <node.h>
 
+
 template <class T>
 class StaticCallbackSetter : public node::ObjectWrap {
 public:
   static v8::Handle<v8::Value> on(const v8::Arguments& args) {
     v8::HandleScope scope;
-    v8::String::Utf8Value callbackName(args[0]->ToString());
-    v8::Handle<v8::Function> fun = v8::Handle<v8::Function>::Cast(args[1]);
-    T::staticCallbacks[*callbackName] = v8::Persistent<v8::Function>::New(fun);
-    return scope.Close(v8::Undefined());
+    T::add(T::staticListeners, args, false);
+    return scope.Close(args.This());
+  };
+
+  static v8::Handle<v8::Value> once(const v8::Arguments& args) {
+    v8::HandleScope scope;
+    T::add(T::staticListeners, args, true);
+    return scope.Close(args.This());
+  };
+
+  static v8::Handle<v8::Value> off(const v8::Arguments& args) {
+    v8::HandleScope scope;
+    return scope.Close(v8::Integer::New(T::remove(T::staticListeners, args)));
   };
 
   static void init(Handle<Object> target, const char* name) {
@@ -43,6 +53,8 @@ public:
     v8::Local<v8::FunctionTemplate> constructorTemplate = v8::FunctionTemplate::New();
     constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
     NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "on", on);
+    NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "once", once);
+    NODE_SET_PROTOTYPE_METHOD(constructorTemplate, "off", off);
     target->Set(v8::String::NewSymbol(name), constructorTemplate->GetFunction()->NewInstance());
     scope.Close(constructorTemplate->GetFunction()->NewInstance());
   };
@@ -28,10 +28,47 @@ THE SOFTWARE.
 #include <string>
 #include <v8.h>
 
+#include "../../events.h"
+#include "Listeners.h"
+
 class V8Callable {
 public:
-  virtual void call(std::string name) = 0;
-  virtual void call(std::string name, v8::Handle<v8::Value> value) = 0;
+  virtual void call(Event event) = 0;
+  virtual void call(Event event, v8::Handle<v8::Value> value) = 0;
+  virtual void callError(Event event, std::string message) = 0;
+  virtual Listeners& getListeners(Event event) = 0;
+  virtual Listeners& getStaticListeners(Event event) = 0;
+  /**
+   * Keep the Javascript object from being garbage collected until unref, e.g. while a request for it is pending.
+   **/
+  virtual void ref() = 0;
+  virtual void unref() = 0;
+};
+
+/**
+ * Holds a ref on a V8Callable while a request is pending. Copies do not hold anything.
+ **/
+class V8CallableRef {
+public:
+  V8CallableRef() : callable(nullptr) {};
+  V8CallableRef(const V8CallableRef& other) : callable(nullptr) {};
+  void hold(V8Callable* _callable) {
+    release();
+    callable = _callable;
+    if(callable != nullptr) {
+      callable->ref();
+    }
+  }
+  void release() {
+    if(callable != nullptr) {
+      V8Callable* released = callable;
+      callable = nullptr;
+      released->unref();
+    }
+  }
+private:
+  V8CallableRef& operator=(const V8CallableRef& other);
+  V8Callable* callable;
 };
 
 #endif
\ No newline at end of file
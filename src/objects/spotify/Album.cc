@@ -24,16 +24,21 @@ THE SOFTWARE.
 
 #include "Album.h"
 #include "../../utils/ImageUtils.h"
+#include "../../utils/MemoryUtils.h"
 #include "../../Application.h"
 #include "../../callbacks/AlbumBrowseCallbacks.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 extern Application* application;
 
-Album::Album(sp_album* _album) : album(_album), cover(nullptr), nodeObject(nullptr), albumBrowse(nullptr) {
+Album::Album(sp_album* _album) : album(_album), cover(nullptr), nodeObject(nullptr), albumBrowse(nullptr), browseRequest(0), externalMemory(0) {
   sp_album_add_ref(album);
 };
 
-Album::Album(const Album& other) : album(other.album), cover(other.cover) {
+Album::Album(const Album& other) : album(other.album), cover(other.cover), nodeObject(nullptr), albumBrowse(other.albumBrowse),
+  browseRequest(0), externalMemory(0) {
   sp_album_add_ref(album);
   if(cover != nullptr) {
     sp_image_add_ref(cover);
@@ -44,44 +49,86 @@ Album::Album(const Album& other) : album(other.album), cover(other.cover) {
 };
 
 Album::~Album() {
+  dispose();
   sp_album_release(album);
+};
+
+/**
+ * Releases the browse result and the cover image and cancels a queued or running browse.
+ * The album can be browsed again afterwards.
+ **/
+void Album::dispose() {
+  if(browseRequest != 0) {
+    application->requestScheduler.remove(browseRequest);
+    browseRequest = 0;
+    browsing.release();
+  }
   if(cover != nullptr) {
     sp_image_release(cover);
+    cover = nullptr;
   }
   if(albumBrowse != nullptr) {
     sp_albumbrowse_release(albumBrowse);
+    albumBrowse = nullptr;
   }
-};
+  MemoryUtils::report(externalMemory, 0);
+}
 
-std::string Album::name() {
-  std::string name;
-  if(sp_album_is_loaded(album)) {
-    name = std::string(sp_album_name(album));
-  } else {
-    name = "Loading...";
+/**
+ * Reports the estimated size of the browse result and the cover image to V8.
+ **/
+void Album::updateExternalMemory() {
+  int bytes = 0;
+  if(isBrowsed()) {
+    bytes += sp_albumbrowse_num_tracks(albumBrowse) * MemoryUtils::OBJECT_SIZE;
+    bytes += strlen(sp_albumbrowse_review(albumBrowse));
+  }
+  if(cover != nullptr && sp_image_is_loaded(cover)) {
+    size_t imageSize;
+    sp_image_data(cover, &imageSize);
+    bytes += imageSize;
   }
-  return name;
+  MemoryUtils::report(externalMemory, bytes);
 }
 
-std::string Album::link() {
-  std::string link;
-  if(sp_album_is_loaded(album)) {
+bool Album::isLoaded() {
+  return sp_album_is_loaded(album);
+}
+
+bool Album::isBrowsed() {
+  return albumBrowse != nullptr && sp_albumbrowse_is_loaded(albumBrowse);
+}
+
+Album::Snapshot* Album::loadSnapshot() {
+  if(!snapshot && sp_album_is_loaded(album)) {
+    snapshot.reset(new Snapshot());
+    snapshot->name = sp_album_name(album);
     char linkChar[256];
     sp_link* spLink = sp_link_create_from_album(album);
     sp_link_as_string(spLink, linkChar, 256);
-    link = std::string(linkChar);
+    snapshot->link = linkChar;
     sp_link_release(spLink);
   }
-  return link;
+  return snapshot.get();
+}
+
+std::string Album::name() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->name : "Loading...";
+}
+
+std::string Album::link() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->link : std::string();
 }
 
 std::vector<std::shared_ptr<Track>> Album::tracks() {
   std::vector<std::shared_ptr<Track>> tracks;
-  if(sp_albumbrowse_is_loaded(albumBrowse)) {
+  if(isBrowsed()) {
     int numTracks = sp_albumbrowse_num_tracks(albumBrowse);
     tracks.resize(numTracks);
     for(int i = 0; i < numTracks; i++) {
-      tracks[i] = std::make_shared<Track>(sp_albumbrowse_track(albumBrowse, i));
+      tracks[i] = application->tracks.get(sp_albumbrowse_track(albumBrowse, i));
     }
   }
   return tracks;
@@ -89,7 +136,7 @@ std::vector<std::shared_ptr<Track>> Album::tracks() {
 
 std::string Album::review() {
   std::string review;
-  if(sp_albumbrowse_is_loaded(albumBrowse)) {
+  if(isBrowsed()) {
     review = std::string(sp_albumbrowse_review(albumBrowse));
   }
   return review;
@@ -97,7 +144,7 @@ std::string Album::review() {
 
 std::vector<std::string> Album::copyrights() {
   std::vector<std::string> copyrights;
-  if(sp_albumbrowse_is_loaded(albumBrowse)) {
+  if(isBrowsed()) {
     int numCopyrights = sp_albumbrowse_num_copyrights(albumBrowse);
     copyrights.resize(numCopyrights);
     for(int i = 0; i < numCopyrights; i++) {
@@ -109,32 +156,47 @@ std::vector<std::string> Album::copyrights() {
 
 std::shared_ptr<Artist> Album::artist() {
   std::shared_ptr<Artist> artist;
-  if(sp_albumbrowse_is_loaded(albumBrowse)) {
-    artist = std::make_shared<Artist>(sp_albumbrowse_artist(albumBrowse));
+  if(isBrowsed()) {
+    artist = application->artists.get(sp_albumbrowse_artist(albumBrowse));
   }
   return artist;
 }
 
+/**
+ * Returns the cover as base64 or an empty string if it is not loaded yet.
+ * The image is kept until the album is disposed, so the next call finds it loaded.
+ **/
 std::string Album::coverBase64() {
-  std::string cover;
-  if(sp_album_is_loaded(album)) {
+  std::string coverBase64;
+  if(cover == nullptr && sp_album_is_loaded(album)) {
     const byte* coverId = sp_album_cover(album, SP_IMAGE_SIZE_NORMAL);
     if(coverId != nullptr) {
-      sp_image* image = sp_image_create(application->session, coverId);
-      if(sp_image_is_loaded(image)) {
-        this->cover = image;
-        cover = std::string(ImageUtils::convertImageToBase64(image));
-      } else {
-        cover = "";
-        sp_image_add_load_callback(image, ImageUtils::imageLoadedCallback, nullptr);
-      }
+      cover = sp_image_create(application->session, coverId);
     }
-  } else {
-    cover = "";
   }
-  return cover;
+  if(cover != nullptr && sp_image_is_loaded(cover)) {
+    char* base64 = ImageUtils::convertImageToBase64(cover);
+    coverBase64 = base64;
+    free(base64);
+    updateExternalMemory();
+  }
+  return coverBase64;
 }
 
-void Album::browse() {
-  this->albumBrowse = sp_albumbrowse_create(application->session, album, AlbumBrowseCallbacks::albumBrowseComplete, this);
+/**
+ * Queue the browse in the request scheduler. Does nothing if a browse is already queued or running.
+ **/
+void Album::browse(RequestPriority priority, int timeout) {
+  if(browseRequest != 0) {
+    return;
+  }
+  browseRequest = application->requestScheduler.schedule(REQUEST_ALBUMBROWSE, priority, timeout,
+    [this]() {
+      albumBrowse = sp_albumbrowse_create(application->session, album, AlbumBrowseCallbacks::albumBrowseComplete, this);
+    },
+    [this]() {
+      AlbumBrowseCallbacks::albumBrowseTimeout(this);
+    }
+  );
+  browsing.hold(nodeObject);
 }
\ No newline at end of file
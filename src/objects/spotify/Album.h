@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "Track.h"
 #include "Artist.h"
 #include "../node/V8Callable.h"
+#include "RequestScheduler.h"
 
 class Track;
 class Artist;
@@ -40,10 +41,13 @@ class Artist;
 class Album {
 friend class NodeAlbum;
 friend class AlbumBrowseCallbacks;
+friend class JsonSerializer;
 public:
   Album(sp_album* _album);
   ~Album();
   Album(const Album& other);
+  bool isLoaded();
+  bool isBrowsed();
   std::string name();
   std::string link();
   std::string coverBase64();
@@ -51,12 +55,27 @@ public:
   std::string review();
   std::vector<std::string> copyrights();
   std::shared_ptr<Artist> artist();
-  void browse();
+  void browse(RequestPriority priority, int timeout);
+  void dispose();
+  void updateExternalMemory();
 private:
+  /**
+   * Name and link, taken once the album is loaded.
+   **/
+  struct Snapshot {
+    std::string name;
+    std::string link;
+  };
+  Snapshot* loadSnapshot();
+  std::unique_ptr<Snapshot> snapshot;
   sp_album* album;
   sp_image* cover;
   V8Callable* nodeObject;
   sp_albumbrowse* albumBrowse;
+  RequestScheduler::RequestId browseRequest;
+  //the Javascript object that waits for the browse
+  V8CallableRef browsing;
+  int externalMemory;
 };
 
 #endif
\ No newline at end of file
@@ -25,14 +25,18 @@ THE SOFTWARE.
 #include "Artist.h"
 #include "../../callbacks/ArtistBrowseCallbacks.h"
 #include "../../Application.h"
+#include "../../utils/MemoryUtils.h"
+
+#include <string.h>
 
 extern Application* application;
 
-Artist::Artist(sp_artist* _artist) : artist(_artist), artistBrowse(nullptr), nodeObject(nullptr) {
+Artist::Artist(sp_artist* _artist) : artist(_artist), artistBrowse(nullptr), browseType(SP_ARTISTBROWSE_FULL), browseRequest(0), nodeObject(nullptr), externalMemory(0) {
   sp_artist_add_ref(artist);
 };
 
- Artist::Artist(const Artist& other) : artist(other.artist), artistBrowse(other.artistBrowse), nodeObject(other.nodeObject) {
+ Artist::Artist(const Artist& other) : artist(other.artist), artistBrowse(other.artistBrowse), browseType(other.browseType), browseRequest(0), nodeObject(other.nodeObject),
+  externalMemory(0) {
   sp_artist_add_ref(artist);
   if(artistBrowse != nullptr) {
     sp_artistbrowse_add_ref(artistBrowse);
@@ -40,45 +44,114 @@ Artist::Artist(sp_artist* _artist) : artist(_artist), artistBrowse(nullptr), nod
 };
 
 Artist::~Artist() {
+  dispose();
   sp_artist_release(artist);
+};
+
+/**
+ * Releases the browse result and cancels a queued or running browse. The artist can be browsed again afterwards.
+ **/
+void Artist::dispose() {
+  if(browseRequest != 0) {
+    application->requestScheduler.remove(browseRequest);
+    browseRequest = 0;
+    browsing.release();
+  }
   if(artistBrowse != nullptr) {
     sp_artistbrowse_release(artistBrowse);
+    artistBrowse = nullptr;
   }
-};
+  MemoryUtils::report(externalMemory, 0);
+}
 
-std::string Artist::name() {
-  std::string name;
-  if(sp_artist_is_loaded(artist)) {
-    name = std::string(sp_artist_name(artist));
-  } else {
-    name = "Loading...";
+/**
+ * Reports the estimated size of the browse result to V8.
+ **/
+void Artist::updateExternalMemory() {
+  int bytes = 0;
+  if(isBrowsed()) {
+    int numObjects = sp_artistbrowse_num_tracks(artistBrowse) + sp_artistbrowse_num_tophit_tracks(artistBrowse)
+      + sp_artistbrowse_num_albums(artistBrowse) + sp_artistbrowse_num_similar_artists(artistBrowse);
+    bytes = numObjects * MemoryUtils::OBJECT_SIZE + strlen(sp_artistbrowse_biography(artistBrowse));
   }
-  return name;
+  MemoryUtils::report(externalMemory, bytes);
 }
 
-std::string Artist::link() {
-  std::string link;
-  if(sp_artist_is_loaded(artist)) {
+bool Artist::isLoaded() {
+  return sp_artist_is_loaded(artist);
+}
+
+bool Artist::isBrowsed() {
+  return artistBrowse != nullptr && sp_artistbrowse_is_loaded(artistBrowse);
+}
+
+Artist::Snapshot* Artist::loadSnapshot() {
+  if(!snapshot && sp_artist_is_loaded(artist)) {
+    snapshot.reset(new Snapshot());
+    snapshot->name = sp_artist_name(artist);
     sp_link* spLink = sp_link_create_from_artist(artist);
     char linkChar[256];
     sp_link_as_string(spLink, linkChar, 256);
-    link = std::string(linkChar);
+    snapshot->link = linkChar;
     sp_link_release(spLink);
   }
-  return link;
+  return snapshot.get();
+}
+
+std::string Artist::name() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->name : "Loading...";
+}
+
+std::string Artist::link() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->link : std::string();
+}
+
+/**
+ * Queue the browse in the request scheduler. Does nothing if a browse is already queued or running.
+ **/
+void Artist::browse(sp_artistbrowse_type artistbrowseType, RequestPriority priority, int timeout) {
+  if(browseRequest != 0) {
+    return;
+  }
+  browseType = artistbrowseType;
+  browseRequest = application->requestScheduler.schedule(REQUEST_ARTISTBROWSE, priority, timeout,
+    [this, artistbrowseType]() {
+      artistBrowse = sp_artistbrowse_create(application->session, artist, artistbrowseType, &ArtistBrowseCallbacks::artistBrowseComplete, this);
+    },
+    [this]() {
+      ArtistBrowseCallbacks::artistBrowseTimeout(this);
+    }
+  );
+  browsing.hold(nodeObject);
 }
 
-void Artist::browse(sp_artistbrowse_type artistbrowseType) {
-  this->artistBrowse = sp_artistbrowse_create(application->session, artist, artistbrowseType, &ArtistBrowseCallbacks::artistBrowseComplete, this);
+/**
+ * How much a browse type includes: FULL has everything, NO_TRACKS the albums but no tracks, NO_ALBUMS neither.
+ **/
+static int browseDetail(sp_artistbrowse_type artistbrowseType) {
+  switch(artistbrowseType) {
+    case SP_ARTISTBROWSE_FULL: return 2;
+    case SP_ARTISTBROWSE_NO_TRACKS: return 1;
+    default: return 0;
+  }
+}
+
+/**
+ * True if the current or queued browse has at least what a browse of artistbrowseType would have.
+ **/
+bool Artist::browseIncludes(sp_artistbrowse_type artistbrowseType) {
+  return browseDetail(browseType) >= browseDetail(artistbrowseType);
 }
 
 std::vector<std::shared_ptr<Track>> Artist::tracks() {
   std::vector<std::shared_ptr<Track>> tracks;
-  if(sp_artistbrowse_is_loaded(artistBrowse)) {
+  if(isBrowsed()) {
     int numTracks = sp_artistbrowse_num_tracks(artistBrowse);
     tracks.resize(numTracks);
     for(int i = 0; i < numTracks; i++) {
-      tracks[i] = std::make_shared<Track>(sp_artistbrowse_track(artistBrowse, i));
+      tracks[i] = application->tracks.get(sp_artistbrowse_track(artistBrowse, i));
     }
   }
   return tracks;
@@ -86,11 +159,11 @@ std::vector<std::shared_ptr<Track>> Artist::tracks() {
 
 std::vector<std::shared_ptr<Track>> Artist::tophitTracks() {
   std::vector<std::shared_ptr<Track>> tophitTracks;
-  if(sp_artistbrowse_is_loaded(artistBrowse)) {
+  if(isBrowsed()) {
     int numTophitTracks = sp_artistbrowse_num_tophit_tracks(artistBrowse);
     tophitTracks.resize(numTophitTracks);
     for(int i = 0; i < numTophitTracks; i++) {
-      tophitTracks[i] = std::make_shared<Track>(sp_artistbrowse_tophit_track(artistBrowse, i));
+      tophitTracks[i] = application->tracks.get(sp_artistbrowse_tophit_track(artistBrowse, i));
     }
   }
   return tophitTracks;
@@ -98,11 +171,11 @@ std::vector<std::shared_ptr<Track>> Artist::tophitTracks() {
 
 std::vector<std::shared_ptr<Album>> Artist::albums() {
   std::vector<std::shared_ptr<Album>> albums;
-  if(sp_artistbrowse_is_loaded(artistBrowse)) {
+  if(isBrowsed()) {
     int numAlbums = sp_artistbrowse_num_albums(artistBrowse);
     albums.resize(numAlbums);
     for(int i = 0; i < numAlbums; i++) {
-      albums[i] = std::make_shared<Album>(sp_artistbrowse_album(artistBrowse, i));
+      albums[i] = application->albums.get(sp_artistbrowse_album(artistBrowse, i));
     }
   }
   return albums;
@@ -110,11 +183,11 @@ std::vector<std::shared_ptr<Album>> Artist::albums() {
 
 std::vector<std::shared_ptr<Artist>> Artist::similarArtists() {
   std::vector<std::shared_ptr<Artist>> similarArtists;
-  if(sp_artistbrowse_is_loaded(artistBrowse)) {
+  if(isBrowsed()) {
     int numSimilarArtists = sp_artistbrowse_num_similar_artists(artistBrowse);
     similarArtists.resize(numSimilarArtists);
     for(int i = 0; i < numSimilarArtists; i++) {
-      similarArtists[i] = std::make_shared<Artist>(sp_artistbrowse_similar_artist(artistBrowse, i));
+      similarArtists[i] = application->artists.get(sp_artistbrowse_similar_artist(artistBrowse, i));
     }
   }
   return similarArtists;
@@ -122,7 +195,7 @@ std::vector<std::shared_ptr<Artist>> Artist::similarArtists() {
 
 std::string Artist::biography() {
   std::string biography;
-  if(sp_artistbrowse_is_loaded(artistBrowse)) {
+  if(isBrowsed()) {
     biography = std::string(sp_artistbrowse_biography(artistBrowse));
   }
   return biography;
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "Track.h"
 #include "Album.h"
 #include "../node/V8Callable.h"
+#include "RequestScheduler.h"
 
 class Track;
 class Album;
@@ -40,11 +41,14 @@ class Album;
 class Artist {
 friend class NodeArtist;
 friend class ArtistBrowseCallbacks;
+friend class JsonSerializer;
 public:
   Artist(sp_artist* _artist);
   Artist(const Artist& other);
   ~Artist();
 
+  bool isLoaded();
+  bool isBrowsed();
   std::string name();
   std::string link();
   std::vector<std::shared_ptr<Track>> tracks();
@@ -52,11 +56,29 @@ public:
   std::vector<std::shared_ptr<Album>> albums();
   std::vector<std::shared_ptr<Artist>> similarArtists();
   std::string biography();
-  void browse(sp_artistbrowse_type artistbrowseType);
+  void browse(sp_artistbrowse_type artistbrowseType, RequestPriority priority, int timeout);
+  bool browseIncludes(sp_artistbrowse_type artistbrowseType);
+  void dispose();
+  void updateExternalMemory();
 private:
+  /**
+   * Name and link, taken once the artist is loaded.
+   **/
+  struct Snapshot {
+    std::string name;
+    std::string link;
+  };
+  Snapshot* loadSnapshot();
+  std::unique_ptr<Snapshot> snapshot;
   sp_artist* artist;
   sp_artistbrowse* artistBrowse;
+  //the type of artistBrowse or of the queued browse
+  sp_artistbrowse_type browseType;
+  RequestScheduler::RequestId browseRequest;
   V8Callable* nodeObject;
+  //the Javascript object that waits for the browse
+  V8CallableRef browsing;
+  int externalMemory;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _IDENTITY_MAP_H
+#define _IDENTITY_MAP_H
+
+#include <map>
+#include <memory>
+
+#include "../../utils/SlabPool.h"
+
+/**
+ * Maps libspotify pointers to the one C++ object that currently wraps them.
+ * The map only holds weak references, an object is removed when its last shared_ptr is gone.
+ * The map must outlive all objects it created.
+ * Objects, their shared_ptr control blocks and the map nodes come from slab pools, so a library of
+ * 50000 tracks does not mean 150000 small heap allocations.
+ **/
+template <class SpType, class T>
+class IdentityMap {
+public:
+  /**
+   * Returns the living object for spObject or creates a new one with the given constructor arguments.
+   **/
+  template <class... Args>
+  std::shared_ptr<T> get(SpType* spObject, Args... args) {
+    auto it = objects.find(spObject);
+    if(it != objects.end()) {
+      std::shared_ptr<T> object = it->second.lock();
+      if(object) {
+        return object;
+      }
+    }
+    T* created = new(SlabPool<sizeof(T)>::allocate()) T(spObject, args...);
+    std::shared_ptr<T> object(created, [this, spObject](T* deleted) {
+      auto it = objects.find(spObject);
+      if(it != objects.end() && it->second.expired()) {
+        objects.erase(it);
+      }
+      deleted->~T();
+      SlabPool<sizeof(T)>::deallocate(deleted);
+    }, PoolAllocator<T>());
+    objects[spObject] = object;
+    return object;
+  }
+  size_t size() {
+    return objects.size();
+  }
+private:
+  typedef std::pair<SpType* const, std::weak_ptr<T>> Entry;
+  std::map<SpType*, std::weak_ptr<T>, std::less<SpType*>, PoolAllocator<Entry>> objects;
+};
+
+#endif
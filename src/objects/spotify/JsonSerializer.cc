@@ -0,0 +1,310 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "JsonSerializer.h"
+#include "TrackColumns.h"
+#include "../../Application.h"
+
+extern Application* application;
+
+/**
+ * Writes the link as a string and releases it.
+ **/
+void JsonSerializer::link(JsonWriter& writer, sp_link* link) {
+  if(link == nullptr) {
+    writer.null();
+    return;
+  }
+  char linkChar[256];
+  sp_link_as_string(link, linkChar, 256);
+  sp_link_release(link);
+  writer.string(linkChar);
+}
+
+/**
+ * createTime and id are only written if they are not -1, they are known in playlists only.
+ * The id is the position of the track in the playlist.
+ **/
+void JsonSerializer::track(JsonWriter& writer, sp_track* track, int trackFields, int createTime, int id) {
+  writer.beginObject();
+  if(id != -1) {
+    writer.key("id");
+    writer.number(id);
+  }
+  if(createTime != -1 && (trackFields & COLUMN_CREATE_TIME)) {
+    writer.key("createTime");
+    writer.number(createTime);
+  }
+  if(!sp_track_is_loaded(track)) {
+    writer.key("loaded");
+    writer.boolean(false);
+    writer.endObject();
+    return;
+  }
+  if(trackFields & COLUMN_NAME) {
+    writer.key("name");
+    writer.string(sp_track_name(track));
+  }
+  if(trackFields & COLUMN_LINK) {
+    writer.key("link");
+    link(writer, sp_link_create_from_track(track, 0));
+  }
+  if(trackFields & COLUMN_DURATION) {
+    //in seconds like track.duration
+    writer.key("duration");
+    writer.number(sp_track_duration(track) / 1000);
+  }
+  if(trackFields & COLUMN_POPULARITY) {
+    writer.key("popularity");
+    writer.number(sp_track_popularity(track));
+  }
+  if(trackFields & COLUMN_STARRED) {
+    writer.key("starred");
+    writer.boolean(sp_track_is_starred(application->session, track));
+  }
+  if(trackFields & COLUMN_ARTIST) {
+    writer.key("artists");
+    writer.beginArray();
+    int numArtists = sp_track_num_artists(track);
+    for(int i = 0; i < numArtists; i++) {
+      artist(writer, sp_track_artist(track, i), nullptr, 0, trackFields);
+    }
+    writer.endArray();
+  }
+  if(trackFields & COLUMN_ALBUM) {
+    writer.key("album");
+    sp_album* spAlbum = sp_track_album(track);
+    if(spAlbum != nullptr) {
+      album(writer, spAlbum, nullptr, 0, trackFields);
+    } else {
+      writer.null();
+    }
+  }
+  writer.endObject();
+}
+
+void JsonSerializer::playlist(JsonWriter& writer, Playlist& playlist, int depth, int trackFields) {
+  JsonSerializer::playlist(writer, playlist.playlist, playlist.id, depth, trackFields);
+}
+
+/**
+ * id is the id the playlist container gave the playlist, it does not change when playlists are added, moved or removed.
+ * It is not written for other playlists (-1).
+ **/
+void JsonSerializer::playlist(JsonWriter& writer, sp_playlist* playlist, int id, int depth, int trackFields) {
+  writer.beginObject();
+  if(id != -1) {
+    writer.key("id");
+    writer.number(id);
+  }
+  if(!sp_playlist_is_loaded(playlist)) {
+    writer.key("loaded");
+    writer.boolean(false);
+    writer.endObject();
+    return;
+  }
+  int numTracks = sp_playlist_num_tracks(playlist);
+  writer.key("name");
+  writer.string(sp_playlist_name(playlist));
+  writer.key("link");
+  link(writer, sp_link_create_from_playlist(playlist));
+  writer.key("numTracks");
+  writer.number(numTracks);
+  if(depth > 0) {
+    writer.key("tracks");
+    writer.beginArray();
+    for(int i = 0; i < numTracks; i++) {
+      track(writer, sp_playlist_track(playlist, i), trackFields, sp_playlist_track_create_time(playlist, i), i);
+    }
+    writer.endArray();
+  }
+  writer.endObject();
+}
+
+void JsonSerializer::album(JsonWriter& writer, Album& album, int depth, int trackFields) {
+  sp_albumbrowse* albumBrowse = album.albumBrowse;
+  if(albumBrowse != nullptr && !sp_albumbrowse_is_loaded(albumBrowse)) {
+    albumBrowse = nullptr;
+  }
+  JsonSerializer::album(writer, album.album, albumBrowse, depth, trackFields);
+}
+
+/**
+ * Tracks, review and copyrights are only written if the album has been browsed.
+ **/
+void JsonSerializer::album(JsonWriter& writer, sp_album* album, sp_albumbrowse* albumBrowse, int depth, int trackFields) {
+  writer.beginObject();
+  if(!sp_album_is_loaded(album)) {
+    writer.key("loaded");
+    writer.boolean(false);
+    writer.endObject();
+    return;
+  }
+  writer.key("name");
+  writer.string(sp_album_name(album));
+  writer.key("link");
+  link(writer, sp_link_create_from_album(album));
+  writer.key("year");
+  writer.number(sp_album_year(album));
+  if(depth > 0) {
+    sp_artist* spArtist = sp_album_artist(album);
+    if(spArtist != nullptr) {
+      writer.key("artist");
+      artist(writer, spArtist, nullptr, 0, trackFields);
+    }
+  }
+  if(depth > 0 && albumBrowse != nullptr) {
+    writer.key("review");
+    writer.string(sp_albumbrowse_review(albumBrowse));
+    writer.key("copyrights");
+    writer.beginArray();
+    int numCopyrights = sp_albumbrowse_num_copyrights(albumBrowse);
+    for(int i = 0; i < numCopyrights; i++) {
+      writer.string(sp_albumbrowse_copyright(albumBrowse, i));
+    }
+    writer.endArray();
+    writer.key("tracks");
+    writer.beginArray();
+    int numTracks = sp_albumbrowse_num_tracks(albumBrowse);
+    for(int i = 0; i < numTracks; i++) {
+      track(writer, sp_albumbrowse_track(albumBrowse, i), trackFields, -1, -1);
+    }
+    writer.endArray();
+  }
+  writer.endObject();
+}
+
+void JsonSerializer::artist(JsonWriter& writer, Artist& artist, int depth, int trackFields) {
+  sp_artistbrowse* artistBrowse = artist.artistBrowse;
+  if(artistBrowse != nullptr && !sp_artistbrowse_is_loaded(artistBrowse)) {
+    artistBrowse = nullptr;
+  }
+  JsonSerializer::artist(writer, artist.artist, artistBrowse, depth, trackFields);
+}
+
+/**
+ * Biography, tracks, albums and similar artists are only written if the artist has been browsed.
+ **/
+void JsonSerializer::artist(JsonWriter& writer, sp_artist* artist, sp_artistbrowse* artistBrowse, int depth, int trackFields) {
+  writer.beginObject();
+  if(!sp_artist_is_loaded(artist)) {
+    writer.key("loaded");
+    writer.boolean(false);
+    writer.endObject();
+    return;
+  }
+  writer.key("name");
+  writer.string(sp_artist_name(artist));
+  writer.key("link");
+  link(writer, sp_link_create_from_artist(artist));
+  if(depth > 0 && artistBrowse != nullptr) {
+    writer.key("biography");
+    writer.string(sp_artistbrowse_biography(artistBrowse));
+    writer.key("tracks");
+    writer.beginArray();
+    int numTracks = sp_artistbrowse_num_tracks(artistBrowse);
+    for(int i = 0; i < numTracks; i++) {
+      track(writer, sp_artistbrowse_track(artistBrowse, i), trackFields, -1, -1);
+    }
+    writer.endArray();
+    writer.key("tophitTracks");
+    writer.beginArray();
+    int numTophitTracks = sp_artistbrowse_num_tophit_tracks(artistBrowse);
+    for(int i = 0; i < numTophitTracks; i++) {
+      track(writer, sp_artistbrowse_tophit_track(artistBrowse, i), trackFields, -1, -1);
+    }
+    writer.endArray();
+    writer.key("albums");
+    writer.beginArray();
+    int numAlbums = sp_artistbrowse_num_albums(artistBrowse);
+    for(int i = 0; i < numAlbums; i++) {
+      album(writer, sp_artistbrowse_album(artistBrowse, i), nullptr, depth - 1, trackFields);
+    }
+    writer.endArray();
+    writer.key("similarArtists");
+    writer.beginArray();
+    int numSimilarArtists = sp_artistbrowse_num_similar_artists(artistBrowse);
+    for(int i = 0; i < numSimilarArtists; i++) {
+      JsonSerializer::artist(writer, sp_artistbrowse_similar_artist(artistBrowse, i), nullptr, depth - 1, trackFields);
+    }
+    writer.endArray();
+  }
+  writer.endObject();
+}
+
+void JsonSerializer::search(JsonWriter& writer, Search& search, int depth, int trackFields) {
+  sp_search* spSearch = search.search;
+  writer.beginObject();
+  if(spSearch == nullptr || !sp_search_is_loaded(spSearch)) {
+    writer.key("loaded");
+    writer.boolean(false);
+    writer.endObject();
+    return;
+  }
+  writer.key("query");
+  writer.string(sp_search_query(spSearch));
+  writer.key("link");
+  link(writer, sp_link_create_from_search(spSearch));
+  writer.key("didYouMean");
+  writer.string(sp_search_did_you_mean(spSearch));
+  writer.key("totalTracks");
+  writer.number(sp_search_total_tracks(spSearch));
+  writer.key("totalAlbums");
+  writer.number(sp_search_total_albums(spSearch));
+  writer.key("totalArtists");
+  writer.number(sp_search_total_artists(spSearch));
+  writer.key("totalPlaylists");
+  writer.number(sp_search_total_playlists(spSearch));
+  if(depth > 0) {
+    writer.key("tracks");
+    writer.beginArray();
+    int numTracks = sp_search_num_tracks(spSearch);
+    for(int i = 0; i < numTracks; i++) {
+      track(writer, sp_search_track(spSearch, i), trackFields, -1, -1);
+    }
+    writer.endArray();
+    writer.key("albums");
+    writer.beginArray();
+    int numAlbums = sp_search_num_albums(spSearch);
+    for(int i = 0; i < numAlbums; i++) {
+      album(writer, sp_search_album(spSearch, i), nullptr, depth - 1, trackFields);
+    }
+    writer.endArray();
+    writer.key("artists");
+    writer.beginArray();
+    int numArtists = sp_search_num_artists(spSearch);
+    for(int i = 0; i < numArtists; i++) {
+      artist(writer, sp_search_artist(spSearch, i), nullptr, depth - 1, trackFields);
+    }
+    writer.endArray();
+    writer.key("playlists");
+    writer.beginArray();
+    int numPlaylists = sp_search_num_playlists(spSearch);
+    for(int i = 0; i < numPlaylists; i++) {
+      playlist(writer, sp_search_playlist(spSearch, i), -1, depth - 1, trackFields);
+    }
+    writer.endArray();
+  }
+  writer.endObject();
+}
@@ -0,0 +1,56 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _JSON_SERIALIZER_H
+#define _JSON_SERIALIZER_H
+
+#include <libspotify/api.h>
+
+#include "../../utils/JsonWriter.h"
+#include "Playlist.h"
+#include "Album.h"
+#include "Artist.h"
+#include "Search.h"
+
+/**
+ * Writes spotify objects as JSON directly from libspotify, without Track objects or Javascript wrappers.
+ * depth 0 writes only the object's own fields, each level more expands the lists of the object
+ * (tracks of a playlist, albums of a browsed artist, ...) with depth - 1.
+ * trackFields is a combination of TrackColumn values and selects what is written for tracks.
+ **/
+class JsonSerializer {
+public:
+  static void playlist(JsonWriter& writer, Playlist& playlist, int depth, int trackFields);
+  static void album(JsonWriter& writer, Album& album, int depth, int trackFields);
+  static void artist(JsonWriter& writer, Artist& artist, int depth, int trackFields);
+  static void search(JsonWriter& writer, Search& search, int depth, int trackFields);
+private:
+  static void track(JsonWriter& writer, sp_track* track, int trackFields, int createTime, int id);
+  static void playlist(JsonWriter& writer, sp_playlist* playlist, int id, int depth, int trackFields);
+  static void album(JsonWriter& writer, sp_album* album, sp_albumbrowse* albumBrowse, int depth, int trackFields);
+  static void artist(JsonWriter& writer, sp_artist* artist, sp_artistbrowse* artistBrowse, int depth, int trackFields);
+  static void link(JsonWriter& writer, sp_link* link);
+};
+
+#endif
@@ -0,0 +1,129 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "MetadataLoader.h"
+
+#include <algorithm>
+
+template <class T>
+static void removeLoadedObjects(std::vector<std::shared_ptr<T>>& objects) {
+  objects.erase(std::remove_if(objects.begin(), objects.end(), [](const std::shared_ptr<T>& object) {
+    return object->isLoaded();
+  }), objects.end());
+}
+
+bool LoadSet::removeLoaded() {
+  removeLoadedObjects(tracks);
+  removeLoadedObjects(albums);
+  removeLoadedObjects(artists);
+  removeLoadedObjects(playlists);
+  return tracks.empty() && albums.empty() && artists.empty() && playlists.empty();
+}
+
+MetadataLoader::MetadataLoader() {
+  uv_timer_init(uv_default_loop(), &timer);
+  timer.data = this;
+  uv_async_init(uv_default_loop(), &checkHandle, &checkLater);
+  checkHandle.data = this;
+}
+
+void MetadataLoader::wait(LoadSet loadSet, int timeout, std::function<void(LoadResult result)> done) {
+  Waiter waiter;
+  waiter.deadline = timeout > 0 ? uv_now(uv_default_loop()) + timeout : 0;
+  waiter.done = done;
+  if(loadSet.removeLoaded()) {
+    //called back from the next turn of the event loop by check
+    uv_async_send(&checkHandle);
+  }
+  waiter.loadSet = loadSet;
+  waiters.push_back(waiter);
+  updateTimer();
+}
+
+void MetadataLoader::checkLater(uv_async_t* handle, int status) {
+  static_cast<MetadataLoader*>(handle->data)->check();
+}
+
+void MetadataLoader::check() {
+  //Collect the finished waiters first, their callbacks may add new waiters.
+  std::vector<std::function<void(LoadResult)>> finished;
+  for(auto it = waiters.begin(); it != waiters.end();) {
+    if(it->loadSet.removeLoaded()) {
+      finished.push_back(it->done);
+      it = waiters.erase(it);
+    } else {
+      it++;
+    }
+  }
+  if(!finished.empty()) {
+    updateTimer();
+  }
+  for(auto it = finished.begin(); it != finished.end(); it++) {
+    (*it)(LOAD_DONE);
+  }
+}
+
+void MetadataLoader::failAll() {
+  std::vector<std::function<void(LoadResult)>> failed;
+  for(auto it = waiters.begin(); it != waiters.end(); it++) {
+    failed.push_back(it->done);
+  }
+  waiters.clear();
+  updateTimer();
+  for(auto it = failed.begin(); it != failed.end(); it++) {
+    (*it)(LOAD_LOGGED_OUT);
+  }
+}
+
+void MetadataLoader::updateTimer() {
+  uv_timer_stop(&timer);
+  uint64_t next = 0;
+  for(auto it = waiters.begin(); it != waiters.end(); it++) {
+    if(it->deadline != 0 && (next == 0 || it->deadline < next)) {
+      next = it->deadline;
+    }
+  }
+  if(next != 0) {
+    uint64_t now = uv_now(uv_default_loop());
+    uv_timer_start(&timer, &checkTimeouts, next > now ? next - now : 0, 0);
+  }
+}
+
+void MetadataLoader::checkTimeouts(uv_timer_t* handle, int status) {
+  MetadataLoader* loader = static_cast<MetadataLoader*>(handle->data);
+  uint64_t now = uv_now(uv_default_loop());
+  std::vector<std::function<void(LoadResult)>> timedOut;
+  for(auto it = loader->waiters.begin(); it != loader->waiters.end();) {
+    if(it->deadline != 0 && it->deadline <= now) {
+      timedOut.push_back(it->done);
+      it = loader->waiters.erase(it);
+    } else {
+      it++;
+    }
+  }
+  loader->updateTimer();
+  for(auto it = timedOut.begin(); it != timedOut.end(); it++) {
+    (*it)(LOAD_TIMED_OUT);
+  }
+}
@@ -0,0 +1,94 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _METADATA_LOADER_H
+#define _METADATA_LOADER_H
+
+#include <uv.h>
+#include <stdint.h>
+#include <list>
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "Track.h"
+#include "Album.h"
+#include "Artist.h"
+#include "Playlist.h"
+
+/**
+ * Objects of which the metadata is awaited.
+ **/
+struct LoadSet {
+  std::vector<std::shared_ptr<Track>> tracks;
+  std::vector<std::shared_ptr<Album>> albums;
+  std::vector<std::shared_ptr<Artist>> artists;
+  std::vector<std::shared_ptr<Playlist>> playlists;
+  /**
+   * Removes the objects that are loaded and returns true if none is left.
+   **/
+  bool removeLoaded();
+};
+
+enum LoadResult {
+  LOAD_DONE,
+  LOAD_TIMED_OUT,
+  LOAD_LOGGED_OUT
+};
+
+/**
+ * Calls back when all objects of a LoadSet are loaded. Instead of polling the pending sets are only
+ * checked when libspotify reports new metadata (metadata_updated, playlist state changes).
+ **/
+class MetadataLoader {
+public:
+  MetadataLoader();
+  /**
+   * done(LOAD_DONE) is called when everything is loaded, done(LOAD_TIMED_OUT) if timeout (in ms, 0 for none) ran out first
+   * and done(LOAD_LOGGED_OUT) if the user logs out before. done is never called from within wait, also not if everything is loaded already.
+   **/
+  void wait(LoadSet loadSet, int timeout, std::function<void(LoadResult result)> done);
+  /**
+   * Checks all pending sets, to be called when metadata has been updated.
+   **/
+  void check();
+  /**
+   * Calls all pending sets back with LOAD_LOGGED_OUT.
+   **/
+  void failAll();
+private:
+  struct Waiter {
+    LoadSet loadSet;
+    uint64_t deadline;
+    std::function<void(LoadResult result)> done;
+  };
+  std::list<Waiter> waiters;
+  uv_timer_t timer;
+  uv_async_t checkHandle;
+  void updateTimer();
+  static void checkTimeouts(uv_timer_t* handle, int status);
+  static void checkLater(uv_async_t* handle, int status);
+};
+
+#endif
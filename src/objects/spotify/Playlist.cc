@@ -24,44 +24,371 @@ THE SOFTWARE.
 
 #include "Playlist.h"
 #include <future>
+#include <algorithm>
+#include <functional>
 #include "../../Application.h"
+#include "../../callbacks/PlaylistCallbacks.h"
 
 extern Application* application;
 
-Playlist::Playlist(sp_playlist* _playlist, int _id) : id(_id), playlist(_playlist), nodeObject(nullptr) {
+//Edits with many tracks are sent to libspotify in chunks of this size
+static const int editChunkSize = 100;
+
+std::set<Playlist*> Playlist::waitingForSync;
+std::unique_ptr<uv_async_t> Playlist::syncCheckHandle;
+
+Playlist::Playlist(sp_playlist* _playlist, int _id) : id(_id), playlist(_playlist), tracksMirrored(false), nodeObject(nullptr) {
   sp_playlist_add_ref(playlist);
 };
 
-std::string Playlist::name() {
-  std::string name;
-  if(sp_playlist_is_loaded(playlist)) {
-    name = std::string(sp_playlist_name(playlist));
-  } else {
-    name = std::string("Loading...");
+/**
+ * Registers the playlist callbacks. Playlists that are still in use are reused, e.g. when the container reloads,
+ * so the callbacks are removed first to not register them twice.
+ **/
+void Playlist::addCallbacks() {
+  playlistCallbacks.playlist_state_changed = &PlaylistCallbacks::playlistStateChanged;
+  playlistCallbacks.playlist_renamed = &PlaylistCallbacks::playlistNameChange;
+  playlistCallbacks.tracks_added = &PlaylistCallbacks::tracksAdded;
+  playlistCallbacks.tracks_removed = &PlaylistCallbacks::tracksRemoved;
+  playlistCallbacks.tracks_moved = &PlaylistCallbacks::tracksMoved;
+  playlistCallbacks.playlist_update_in_progress = &PlaylistCallbacks::playlistUpdateInProgress;
+  //playlistCallbacks.track_created_changed = &track_created_changed;
+  sp_playlist_remove_callbacks(playlist, &playlistCallbacks, this);
+  sp_playlist_add_callbacks(playlist, &playlistCallbacks, this);
+}
+
+/**
+ * Adds the tracks at position, or at the end if position is -1.
+ * If a chunk fails the chunks before it stay added, applied is the number of tracks that were added.
+ **/
+sp_error Playlist::addTracks(const std::vector<std::shared_ptr<Track>>& addedTracks, int position, int& applied) {
+  applied = 0;
+  if(position == -1) {
+    position = sp_playlist_num_tracks(playlist);
   }
-  return name;
+  std::vector<sp_track*> spTracks(addedTracks.size());
+  for(size_t i = 0; i < addedTracks.size(); i++) {
+    spTracks[i] = addedTracks[i]->track;
+  }
+  for(size_t offset = 0; offset < spTracks.size(); offset += editChunkSize) {
+    int chunk = std::min((int)(spTracks.size() - offset), editChunkSize);
+    sp_error error = sp_playlist_add_tracks(playlist, &spTracks[offset], chunk, position + offset, application->session);
+    if(error != SP_ERROR_OK) {
+      return error;
+    }
+    applied += chunk;
+  }
+  return SP_ERROR_OK;
 }
 
-std::string Playlist::link() {
-  std::string link;
-  if(sp_playlist_is_loaded(playlist)) {
+/**
+ * Removes the tracks at indices. The chunks go from the end of the playlist to the start, so removing a chunk
+ * does not move the tracks of the chunks that are still to be removed. As with addTracks applied is the number of tracks
+ * that were removed before a chunk failed.
+ **/
+sp_error Playlist::removeTracks(std::vector<int> indices, int& applied) {
+  applied = 0;
+  std::sort(indices.begin(), indices.end(), std::greater<int>());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  for(size_t offset = 0; offset < indices.size(); offset += editChunkSize) {
+    int chunk = std::min((int)(indices.size() - offset), editChunkSize);
+    sp_error error = sp_playlist_remove_tracks(playlist, &indices[offset], chunk);
+    if(error != SP_ERROR_OK) {
+      return error;
+    }
+    applied += chunk;
+  }
+  return SP_ERROR_OK;
+}
+
+/**
+ * Moves the tracks at indices in front of the track at newPosition. This is one call, split up the moved tracks would end up in a different order.
+ **/
+sp_error Playlist::reorderTracks(const std::vector<int>& indices, int newPosition) {
+  if(indices.empty()) {
+    return SP_ERROR_OK;
+  }
+  return sp_playlist_reorder_tracks(playlist, &indices[0], indices.size(), newPosition);
+}
+
+sp_error Playlist::rename(const std::string& name) {
+  return sp_playlist_rename(playlist, name.c_str());
+}
+
+/**
+ * Calls callback with true once libspotify has no pending changes for the playlist, i.e. the edits are synchronized,
+ * or with false if the user logs out or the playlist is released before that.
+ * The callback is never called from within whenSynced, also not for edits that changed nothing.
+ **/
+void Playlist::whenSynced(std::function<void(bool synced)> callback) {
+  if(!syncCheckHandle) {
+    syncCheckHandle = std::unique_ptr<uv_async_t>(new uv_async_t());
+    uv_async_init(uv_default_loop(), syncCheckHandle.get(), &checkWaitingForSync);
+  }
+  syncCallbacks.push_back(callback);
+  waitingForSync.insert(this);
+  uv_async_send(syncCheckHandle.get());
+}
+
+/**
+ * Runs when libspotify finished an update or the state of the playlist changed.
+ **/
+void Playlist::checkSynced() {
+  if(!syncCallbacks.empty() && !sp_playlist_has_pending_changes(playlist)) {
+    callSyncCallbacks(true);
+  }
+}
+
+void Playlist::callSyncCallbacks(bool synced) {
+  std::vector<std::function<void(bool synced)>> callbacks;
+  callbacks.swap(syncCallbacks);
+  waitingForSync.erase(this);
+  for(auto it = callbacks.begin(); it != callbacks.end(); it++) {
+    (*it)(synced);
+  }
+}
+
+void Playlist::checkWaitingForSync(uv_async_t* handle, int status) {
+  //the callbacks can edit playlists again, so go over a copy
+  std::vector<Playlist*> playlists(waitingForSync.begin(), waitingForSync.end());
+  for(auto it = playlists.begin(); it != playlists.end(); it++) {
+    if(waitingForSync.count(*it) > 0) {
+      (*it)->checkSynced();
+    }
+  }
+}
+
+/**
+ * Fails the sync callbacks of all playlists, their changes will not be synchronized after a logout.
+ **/
+void Playlist::failPendingSyncs() {
+  std::vector<Playlist*> playlists(waitingForSync.begin(), waitingForSync.end());
+  for(auto it = playlists.begin(); it != playlists.end(); it++) {
+    if(waitingForSync.count(*it) > 0) {
+      (*it)->callSyncCallbacks(false);
+    }
+  }
+}
+
+bool Playlist::isLoaded() {
+  return sp_playlist_is_loaded(playlist);
+}
+
+Playlist::Snapshot* Playlist::loadSnapshot() {
+  if(!snapshot && sp_playlist_is_loaded(playlist)) {
+    snapshot.reset(new Snapshot());
+    snapshot->name = sp_playlist_name(playlist);
     sp_link* spLink = sp_link_create_from_playlist(playlist);
     if(spLink != nullptr) {
       char linkChar[256];
       sp_link_as_string(spLink, linkChar, 256);
-      link = std::string(linkChar);
+      snapshot->link = linkChar;
       sp_link_release(spLink);
     }
   }
-  return link;
+  return snapshot.get();
+}
+
+std::string Playlist::name() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->name : "Loading...";
+}
+
+std::string Playlist::link() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->link : std::string();
 }
 
 std::vector<std::shared_ptr<Track>> Playlist::getTracks() {
-  std::vector<std::shared_ptr<Track>> tracks(sp_playlist_num_tracks(playlist));
-  for(int i = 0; i < (int)tracks.size(); ++i) {
-    tracks[i] = std::make_shared<Track>(sp_playlist_track(playlist, i));
+  if(mirrorTracks()) {
+    return tracks;
+  }
+  std::vector<std::shared_ptr<Track>> playlistTracks(sp_playlist_num_tracks(playlist));
+  for(int i = 0; i < (int)playlistTracks.size(); ++i) {
+    playlistTracks[i] = application->tracks.get(sp_playlist_track(playlist, i));
+  }
+  return playlistTracks;
+}
+
+int Playlist::numTracks() {
+  return tracksMirrored ? tracks.size() : sp_playlist_num_tracks(playlist);
+}
+
+/**
+ * Reads all tracks into the mirror if the playlist is loaded. Returns if the mirror can be used.
+ **/
+bool Playlist::mirrorTracks() {
+  if(!tracksMirrored && sp_playlist_is_loaded(playlist)) {
+    int numTracks = sp_playlist_num_tracks(playlist);
+    tracks.resize(numTracks);
+    for(int i = 0; i < numTracks; ++i) {
+      tracks[i] = application->tracks.get(sp_playlist_track(playlist, i));
+    }
+    tracksMirrored = true;
+  }
+  return tracksMirrored;
+}
+
+/**
+ * After a change the mirror must have as many tracks as the playlist, otherwise a change was missed
+ * and the mirror is dropped to be read again on the next getTracks.
+ **/
+void Playlist::checkMirror() {
+  if(tracksMirrored && (int)tracks.size() != sp_playlist_num_tracks(playlist)) {
+    tracks.clear();
+    tracksMirrored = false;
+  }
+}
+
+void Playlist::tracksAdded(sp_track* const* addedTracks, int numTracks, int position) {
+  if(tracksMirrored) {
+    std::vector<std::shared_ptr<Track>> inserted(numTracks);
+    for(int i = 0; i < numTracks; i++) {
+      inserted[i] = application->tracks.get(addedTracks[i]);
+    }
+    tracks.insert(tracks.begin() + std::min(position, (int)tracks.size()), inserted.begin(), inserted.end());
+    checkMirror();
+  }
+}
+
+/**
+ * Removes the tracks at indices (positions before the removal).
+ **/
+void Playlist::tracksRemoved(const int* indices, int numTracks) {
+  if(tracksMirrored) {
+    removeFromMirror(indices, numTracks);
+    checkMirror();
+  }
+}
+
+void Playlist::removeFromMirror(const int* indices, int numTracks) {
+  std::vector<bool> removed(tracks.size(), false);
+  for(int i = 0; i < numTracks; i++) {
+    if(indices[i] >= 0 && indices[i] < (int)tracks.size()) {
+      removed[indices[i]] = true;
+    }
+  }
+  int kept = 0;
+  for(int i = 0; i < (int)tracks.size(); i++) {
+    if(!removed[i]) {
+      tracks[kept++] = tracks[i];
+    }
+  }
+  tracks.resize(kept);
+}
+
+/**
+ * Moves the tracks at indices in front of the track that was at newPosition before the move, keeping their order.
+ * Returns the position of the first moved track after the move.
+ **/
+int Playlist::tracksMoved(const int* indices, int numTracks, int newPosition) {
+  int before = 0;
+  for(int i = 0; i < numTracks; i++) {
+    if(indices[i] < newPosition) {
+      before++;
+    }
+  }
+  int position = newPosition - before;
+  if(tracksMirrored) {
+    std::vector<int> sorted(indices, indices + numTracks);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::shared_ptr<Track>> moved;
+    moved.reserve(numTracks);
+    for(auto it = sorted.begin(); it != sorted.end(); it++) {
+      if(*it >= 0 && *it < (int)tracks.size()) {
+        moved.push_back(tracks[*it]);
+      }
+    }
+    removeFromMirror(indices, numTracks);
+    tracks.insert(tracks.begin() + std::min(position, (int)tracks.size()), moved.begin(), moved.end());
+    checkMirror();
+  }
+  return position;
+}
+
+/**
+ * Walks all tracks once and collects the requested columns (a combination of TrackColumn values).
+ * No Track objects are created.
+ **/
+TrackColumns Playlist::exportColumns(int columns) {
+  TrackColumns trackColumns;
+  int numTracks = sp_playlist_num_tracks(playlist);
+  trackColumns.numTracks = numTracks;
+  if(columns & COLUMN_DURATION) {
+    trackColumns.duration.resize(numTracks);
+  }
+  if(columns & COLUMN_POPULARITY) {
+    trackColumns.popularity.resize(numTracks);
+  }
+  if(columns & COLUMN_STARRED) {
+    trackColumns.starred.resize(numTracks);
+  }
+  if(columns & COLUMN_CREATE_TIME) {
+    trackColumns.createTime.resize(numTracks);
+  }
+  char linkChar[256];
+  std::string artists;
+  for(int i = 0; i < numTracks; i++) {
+    sp_track* track = sp_playlist_track(playlist, i);
+    bool loaded = sp_track_is_loaded(track);
+    if(columns & COLUMN_CREATE_TIME) {
+      trackColumns.createTime[i] = sp_playlist_track_create_time(playlist, i);
+    }
+    if(loaded && (columns & COLUMN_DURATION)) {
+      trackColumns.duration[i] = sp_track_duration(track);
+    }
+    if(loaded && (columns & COLUMN_POPULARITY)) {
+      trackColumns.popularity[i] = sp_track_popularity(track);
+    }
+    if(loaded && (columns & COLUMN_STARRED)) {
+      trackColumns.starred[i] = sp_track_is_starred(application->session, track);
+    }
+    if(columns & COLUMN_NAME) {
+      trackColumns.name.add(loaded ? sp_track_name(track) : nullptr);
+    }
+    if(columns & COLUMN_LINK) {
+      sp_link* spLink = loaded ? sp_link_create_from_track(track, 0) : nullptr;
+      if(spLink != nullptr) {
+        sp_link_as_string(spLink, linkChar, 256);
+        sp_link_release(spLink);
+        trackColumns.link.add(linkChar);
+      } else {
+        trackColumns.link.add(nullptr);
+      }
+    }
+    if(columns & COLUMN_ARTIST) {
+      //all artists of the track, comma separated
+      artists.clear();
+      int numArtists = loaded ? sp_track_num_artists(track) : 0;
+      for(int j = 0; j < numArtists; j++) {
+        sp_artist* artist = sp_track_artist(track, j);
+        if(artist != nullptr && sp_artist_is_loaded(artist)) {
+          if(!artists.empty()) {
+            artists.append(", ");
+          }
+          artists.append(sp_artist_name(artist));
+        }
+      }
+      trackColumns.artist.add(artists.c_str());
+    }
+    if(columns & COLUMN_ALBUM) {
+      sp_album* album = loaded ? sp_track_album(track) : nullptr;
+      trackColumns.album.add(album != nullptr && sp_album_is_loaded(album) ? sp_album_name(album) : nullptr);
+    }
+  }
+  if(columns & COLUMN_NAME) {
+    trackColumns.name.finish();
+  }
+  if(columns & COLUMN_LINK) {
+    trackColumns.link.finish();
+  }
+  if(columns & COLUMN_ARTIST) {
+    trackColumns.artist.finish();
+  }
+  if(columns & COLUMN_ALBUM) {
+    trackColumns.album.finish();
   }
-  return tracks;
+  return trackColumns;
 }
 
 sp_playlist_callbacks Playlist::playlistCallbacks;
\ No newline at end of file
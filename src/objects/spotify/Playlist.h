@@ -28,31 +28,81 @@ THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <set>
 #include <libspotify/api.h>
+#include <uv.h>
 
 #include "../node/V8Callable.h"
 
 #include "Track.h"
+#include "TrackColumns.h"
 
 class Playlist {
 friend class NodePlaylist;
 friend class PlaylistCallbacks;
 friend class PlaylistContainer;
+friend class JsonSerializer;
 public:
   Playlist(sp_playlist* _playlist, int _id);
-  ~Playlist() {
+  virtual ~Playlist() {
+    callSyncCallbacks(false);
+    sp_playlist_remove_callbacks(playlist, &playlistCallbacks, this);
     sp_playlist_release(playlist);
   };
-  Playlist(const Playlist& other) : id(other.id), playlist(other.playlist), nodeObject(other.nodeObject) {
+  Playlist(const Playlist& other) : id(other.id), playlist(other.playlist), tracksMirrored(false), nodeObject(other.nodeObject) {
     sp_playlist_add_ref(playlist);
   }
 
   std::vector<std::shared_ptr<Track>> getTracks();
+  int numTracks();
+  TrackColumns exportColumns(int columns);
+  void addCallbacks();
+  sp_error addTracks(const std::vector<std::shared_ptr<Track>>& addedTracks, int position, int& applied);
+  sp_error removeTracks(std::vector<int> indices, int& applied);
+  sp_error reorderTracks(const std::vector<int>& indices, int newPosition);
+  sp_error rename(const std::string& name);
+  void whenSynced(std::function<void(bool synced)> callback);
+  void checkSynced();
+  static void failPendingSyncs();
+  bool isLoaded();
   virtual std::string name();
   std::string link();
 private:
+  /**
+   * Name and link, taken once the playlist is loaded. Renaming the playlist resets it.
+   **/
+  struct Snapshot {
+    std::string name;
+    std::string link;
+  };
+  Snapshot* loadSnapshot();
+  std::unique_ptr<Snapshot> snapshot;
   int id;
   sp_playlist* playlist;
+  /**
+   * The tracks of the playlist, built on the first getTracks once the playlist is loaded
+   * and from then on patched by the playlist callbacks instead of being read again.
+   **/
+  std::vector<std::shared_ptr<Track>> tracks;
+  bool tracksMirrored;
+  /**
+   * Callbacks of edits that wait until libspotify has no pending changes for the playlist anymore.
+   **/
+  std::vector<std::function<void(bool synced)>> syncCallbacks;
+  void callSyncCallbacks(bool synced);
+  /**
+   * The playlists with sync callbacks, they are checked on the next turn of the event loop after whenSynced and failed on logout.
+   **/
+  static std::set<Playlist*> waitingForSync;
+  static std::unique_ptr<uv_async_t> syncCheckHandle;
+  static void checkWaitingForSync(uv_async_t* handle, int status);
+  bool mirrorTracks();
+  void checkMirror();
+  void tracksAdded(sp_track* const* addedTracks, int numTracks, int position);
+  void tracksRemoved(const int* indices, int numTracks);
+  void removeFromMirror(const int* indices, int numTracks);
+  int tracksMoved(const int* indices, int numTracks, int newPosition);
   static sp_playlist_callbacks playlistCallbacks;
   V8Callable* nodeObject;
 };
@@ -23,30 +23,173 @@ THE SOFTWARE.
 **/
 
 #include "PlaylistContainer.h"
-#include "../../callbacks/PlaylistCallbacks.h"
 #include "../../Application.h"
 #include "StarredPlaylist.h"
+#include "../../callbacks/SessionCallbacks.h"
+#include "../../callbacks/PlaylistContainerCallbacks.h"
+
+#include <algorithm>
 
 extern Application* application;
 
+PlaylistContainer::~PlaylistContainer() {
+  sp_playlistcontainer_remove_callbacks(playlistContainer, &playlistContainerCallbacks, this);
+}
+
+void PlaylistContainer::addCallbacks() {
+  playlistContainerCallbacks.container_loaded = &SessionCallbacks::rootPlaylistContainerLoaded;
+  playlistContainerCallbacks.playlist_added = &PlaylistContainerCallbacks::playlistAdded;
+  playlistContainerCallbacks.playlist_removed = &PlaylistContainerCallbacks::playlistRemoved;
+  playlistContainerCallbacks.playlist_moved = &PlaylistContainerCallbacks::playlistMoved;
+  sp_playlistcontainer_add_callbacks(playlistContainer, &playlistContainerCallbacks, this);
+}
+
+/**
+ * Reads the entry at position from libspotify. Playlists that are still in use keep their object and id.
+ **/
+ContainerItem PlaylistContainer::readItem(int position) {
+  ContainerItem item;
+  item.type = sp_playlistcontainer_playlist_type(playlistContainer, position);
+  if(item.type == SP_PLAYLIST_TYPE_PLAYLIST) {
+    item.playlist = application->playlists.get(sp_playlistcontainer_playlist(playlistContainer, position), -1);
+    if(item.playlist->id == -1) {
+      item.playlist->id = nextId++;
+    }
+    item.playlist->addCallbacks();
+    item.id = item.playlist->id;
+  } else if(item.type == SP_PLAYLIST_TYPE_START_FOLDER || item.type == SP_PLAYLIST_TYPE_END_FOLDER) {
+    //start and end of a folder have the same folder id
+    uint64_t folderId = sp_playlistcontainer_playlist_folder_id(playlistContainer, position);
+    auto it = folderIds.find(folderId);
+    if(it == folderIds.end()) {
+      it = folderIds.insert(std::make_pair(folderId, nextId++)).first;
+    }
+    item.id = it->second;
+    if(item.type == SP_PLAYLIST_TYPE_START_FOLDER) {
+      char folderName[256];
+      if(sp_playlistcontainer_playlist_folder_name(playlistContainer, position, folderName, sizeof(folderName)) == SP_ERROR_OK) {
+        item.folderName = folderName;
+      }
+    }
+  } else {
+    item.id = -1;
+  }
+  return item;
+}
+
+/**
+ * Reads all entries of the container. This runs once when the container is loaded, all changes after that are
+ * applied one by one by the container callbacks, also when the same user logs in again.
+ **/
 void PlaylistContainer::loadPlaylists() {
+  if(loaded) {
+    return;
+  }
+  loaded = true;
   int numPlaylists = sp_playlistcontainer_num_playlists(playlistContainer);
-  playlists.resize(numPlaylists);
+  std::vector<ContainerItem> loadedItems(numPlaylists);
+  for(int i = 0; i < numPlaylists; ++i) {
+    loadedItems[i] = readItem(i);
+  }
+  items.swap(loadedItems);
+
+  if(!starredPlaylist) {
+    sp_playlist* spPlaylist = sp_session_starred_create(application->session);
+    starredPlaylist = std::make_shared<StarredPlaylist>(spPlaylist, nextId++);
+    sp_playlist_release(spPlaylist);
+    starredPlaylist->addCallbacks();
+  }
+}
 
-  Playlist::playlistCallbacks.playlist_state_changed = &PlaylistCallbacks::playlistStateChanged;
-  Playlist::playlistCallbacks.playlist_renamed = &PlaylistCallbacks::playlistNameChange;
-  Playlist::playlistCallbacks.tracks_added = &PlaylistCallbacks::tracksAdded;
-  //Playlist::playlistCallbacks.tracks_moved = &PlaylistCallbacks::tracks_moved;
-  /*playlistCallbacks.playlist_update_in_progress = &playlist_update_in_progress;
-  playlistCallbacks.track_created_changed = &track_created_changed;*/
+/**
+ * Only the playlists, without folders, in the order of the container.
+ **/
+std::vector<std::shared_ptr<Playlist>> PlaylistContainer::getPlaylists() {
+  std::vector<std::shared_ptr<Playlist>> playlists;
+  playlists.reserve(items.size());
+  for(auto it = items.begin(); it != items.end(); it++) {
+    if(it->playlist) {
+      playlists.push_back(it->playlist);
+    }
+  }
+  return playlists;
+}
 
-  for(int i = 0; i < numPlaylists; ++i) {
-    sp_playlist* spPlaylist = sp_playlistcontainer_playlist(playlistContainer, i);
-    playlists[i] = std::make_shared<Playlist>(spPlaylist, i);
-    sp_playlist_add_callbacks(spPlaylist, &Playlist::playlistCallbacks, playlists[i].get());
+const ContainerItem& PlaylistContainer::playlistAdded(int position) {
+  position = std::min(position, (int)items.size());
+  return *items.insert(items.begin() + position, readItem(position));
+}
+
+ContainerItem PlaylistContainer::playlistRemoved(int position) {
+  ContainerItem item;
+  if(position >= 0 && position < (int)items.size()) {
+    item = items[position];
+    items.erase(items.begin() + position);
+  }
+  return item;
+}
+
+/**
+ * libspotify gives the new position as an index before the move. Returns the index of the entry after the move.
+ **/
+int PlaylistContainer::playlistMoved(int position, int newPosition) {
+  if(position < 0 || position >= (int)items.size()) {
+    return -1;
   }
+  int movedTo = newPosition > position ? newPosition - 1 : newPosition;
+  movedTo = std::min(movedTo, (int)items.size() - 1);
+  ContainerItem item = items[position];
+  items.erase(items.begin() + position);
+  items.insert(items.begin() + movedTo, item);
+  return movedTo;
+}
+
+bool PlaylistContainer::allPlaylistsLoaded() {
+  for(auto it = items.begin(); it != items.end(); it++) {
+    if(it->playlist && !sp_playlist_is_loaded(it->playlist->playlist)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  sp_playlist* spPlaylist = sp_session_starred_create(application->session);
-  starredPlaylist = std::make_shared<StarredPlaylist>(spPlaylist, numPlaylists);
-  sp_playlist_add_callbacks(spPlaylist, &Playlist::playlistCallbacks, starredPlaylist.get());
+/**
+ * Marks a playlist for offline use. libspotify will then download its tracks in the background
+ * and report the progress via the offline_status_updated session callback.
+ **/
+void PlaylistContainer::setOfflineMode(std::shared_ptr<Playlist> playlist, bool offline) {
+  sp_playlist_set_offline_mode(application->session, playlist->playlist, offline);
+}
+
+sp_playlist_offline_status PlaylistContainer::offlineStatus(std::shared_ptr<Playlist> playlist) {
+  return sp_playlist_get_offline_status(application->session, playlist->playlist);
+}
+
+/**
+ * Percentage of the playlist that has been downloaded. Only meaningful while the playlist is downloading.
+ **/
+int PlaylistContainer::offlineDownloadCompleted(std::shared_ptr<Playlist> playlist) {
+  return sp_playlist_get_offline_download_completed(application->session, playlist->playlist);
 }
+
+OfflineSyncStatus PlaylistContainer::offlineSyncStatus() {
+  OfflineSyncStatus status = OfflineSyncStatus();
+  sp_offline_sync_status spStatus;
+  if(sp_offline_sync_get_status(application->session, &spStatus)) {
+    status.syncing = spStatus.syncing;
+    status.queuedTracks = spStatus.queued_tracks;
+    status.queuedBytes = spStatus.queued_bytes;
+    status.doneTracks = spStatus.done_tracks;
+    status.doneBytes = spStatus.done_bytes;
+    status.copiedTracks = spStatus.copied_tracks;
+    status.copiedBytes = spStatus.copied_bytes;
+    status.willNotCopyTracks = spStatus.willnotcopy_tracks;
+    status.errorTracks = spStatus.error_tracks;
+  }
+  status.tracksToSync = sp_offline_tracks_to_sync(application->session);
+  status.offlinePlaylists = sp_offline_num_playlists(application->session);
+  status.timeLeft = sp_offline_time_left(application->session);
+  return status;
+}
+
+sp_playlistcontainer_callbacks PlaylistContainer::playlistContainerCallbacks;
@@ -28,18 +28,71 @@ THE SOFTWARE.
 #include <libspotify/api.h>
 #include <vector>
 #include <memory>
+#include <map>
+#include <string>
+#include <stdint.h>
 
 #include "Playlist.h"
 
+/**
+ * Aggregated progress of the offline synchronisation of all playlists marked for offline use.
+ **/
+struct OfflineSyncStatus {
+  bool syncing;
+  int queuedTracks;
+  uint64_t queuedBytes;
+  int doneTracks;
+  uint64_t doneBytes;
+  int copiedTracks;
+  uint64_t copiedBytes;
+  int willNotCopyTracks;
+  int errorTracks;
+  int tracksToSync;
+  int offlinePlaylists;
+  int timeLeft; //seconds until the offline key store expires
+};
+
+/**
+ * One entry of the container: a playlist, or the start or end of a folder.
+ * The ids of playlists and folders stay the same while the module runs, also when the container changes.
+ **/
+struct ContainerItem {
+  sp_playlist_type type;
+  int id;
+  std::shared_ptr<Playlist> playlist; //only for SP_PLAYLIST_TYPE_PLAYLIST
+  std::string folderName; //only for SP_PLAYLIST_TYPE_START_FOLDER
+};
+
 class PlaylistContainer {
+friend class SessionCallbacks;
 public:
-  PlaylistContainer(sp_playlistcontainer* _playlistContainer) : playlistContainer(_playlistContainer) {};
+  PlaylistContainer(sp_playlistcontainer* _playlistContainer) : playlistContainer(_playlistContainer), nextId(0), loaded(false) {};
+  ~PlaylistContainer();
+  void addCallbacks();
   void loadPlaylists();
-  std::vector<std::shared_ptr<Playlist>> getPlaylists() { return playlists; };
+  bool isLoaded() { return loaded; };
+  std::vector<std::shared_ptr<Playlist>> getPlaylists();
+  const std::vector<ContainerItem>& getItems() { return items; };
+  const ContainerItem& playlistAdded(int position);
+  ContainerItem playlistRemoved(int position);
+  int playlistMoved(int position, int newPosition);
+  bool allPlaylistsLoaded();
+  void setOfflineMode(std::shared_ptr<Playlist> playlist, bool offline);
+  sp_playlist_offline_status offlineStatus(std::shared_ptr<Playlist> playlist);
+  int offlineDownloadCompleted(std::shared_ptr<Playlist> playlist);
+  OfflineSyncStatus offlineSyncStatus();
   std::shared_ptr<Playlist> starredPlaylist;
 private:
+  ContainerItem readItem(int position);
   sp_playlistcontainer* playlistContainer;
-  std::vector<std::shared_ptr<Playlist>> playlists;
+  /**
+   * The entries in the order of the container, kept up to date by the container callbacks.
+   **/
+  std::vector<ContainerItem> items;
+  std::map<uint64_t, int> folderIds;
+  int nextId;
+  bool loaded;
+  static sp_playlistcontainer_callbacks playlistContainerCallbacks;
 };
 
 #endif
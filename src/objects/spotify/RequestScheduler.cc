@@ -0,0 +1,157 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "RequestScheduler.h"
+
+RequestScheduler::RequestScheduler() : nextId(1) {
+  for(int i = 0; i < REQUEST_TYPE_COUNT; i++) {
+    requestStats[i] = RequestStats();
+  }
+  requestStats[REQUEST_SEARCH].limit = 4;
+  requestStats[REQUEST_ALBUMBROWSE].limit = 8;
+  requestStats[REQUEST_ARTISTBROWSE].limit = 4;
+  uv_timer_init(uv_default_loop(), &timer);
+  timer.data = this;
+}
+
+RequestScheduler::RequestId RequestScheduler::schedule(RequestType type, RequestPriority priority, int timeout,
+    std::function<void()> start, std::function<void()> cancel) {
+  RequestId id = nextId++;
+  Request request;
+  request.type = type;
+  request.priority = priority;
+  request.deadline = timeout > 0 ? uv_now(uv_default_loop()) + timeout : 0;
+  request.running = false;
+  request.start = start;
+  request.cancel = cancel;
+  requests[id] = request;
+  queues[type][priority].push_back(id);
+  requestStats[type].queued[priority]++;
+  if(request.deadline != 0) {
+    deadlines.insert(std::make_pair(request.deadline, id));
+    updateTimer();
+  }
+  startNext(type);
+  return id;
+}
+
+void RequestScheduler::complete(RequestId id) {
+  auto it = requests.find(id);
+  if(it != requests.end()) {
+    RequestType type = it->second.type;
+    requestStats[type].completed++;
+    finish(it);
+    startNext(type);
+  }
+}
+
+void RequestScheduler::remove(RequestId id) {
+  auto it = requests.find(id);
+  if(it != requests.end()) {
+    RequestType type = it->second.type;
+    finish(it);
+    startNext(type);
+  }
+}
+
+void RequestScheduler::setLimit(RequestType type, int limit) {
+  requestStats[type].limit = limit;
+  startNext(type);
+}
+
+RequestStats RequestScheduler::stats(RequestType type) {
+  return requestStats[type];
+}
+
+/**
+ * Forget a request and update the counters. The queue entry is skipped later.
+ **/
+void RequestScheduler::finish(std::map<RequestId, Request>::iterator it) {
+  Request& request = it->second;
+  if(request.running) {
+    requestStats[request.type].inFlight--;
+  } else {
+    requestStats[request.type].queued[request.priority]--;
+  }
+  if(request.deadline != 0) {
+    auto range = deadlines.equal_range(request.deadline);
+    for(auto deadlineIt = range.first; deadlineIt != range.second; deadlineIt++) {
+      if(deadlineIt->second == it->first) {
+        deadlines.erase(deadlineIt);
+        break;
+      }
+    }
+  }
+  requests.erase(it);
+}
+
+void RequestScheduler::startNext(RequestType type) {
+  RequestStats& stats = requestStats[type];
+  for(int priority = 0; priority < PRIORITY_COUNT; priority++) {
+    std::deque<RequestId>& queue = queues[type][priority];
+    while(!queue.empty() && stats.inFlight < stats.limit) {
+      RequestId id = queue.front();
+      queue.pop_front();
+      auto it = requests.find(id);
+      if(it == requests.end()) {
+        continue;
+      }
+      it->second.running = true;
+      stats.queued[priority]--;
+      stats.inFlight++;
+      stats.started++;
+      //copy, the start function may schedule or complete other requests
+      std::function<void()> start = it->second.start;
+      start();
+    }
+  }
+}
+
+void RequestScheduler::updateTimer() {
+  uv_timer_stop(&timer);
+  if(!deadlines.empty()) {
+    uint64_t now = uv_now(uv_default_loop());
+    uint64_t next = deadlines.begin()->first;
+    uv_timer_start(&timer, &checkTimeouts, next > now ? next - now : 0, 0);
+  }
+}
+
+void RequestScheduler::checkTimeouts(uv_timer_t* handle, int status) {
+  RequestScheduler* scheduler = static_cast<RequestScheduler*>(handle->data);
+  uint64_t now = uv_now(uv_default_loop());
+  while(!scheduler->deadlines.empty() && scheduler->deadlines.begin()->first <= now) {
+    auto it = scheduler->requests.find(scheduler->deadlines.begin()->second);
+    if(it == scheduler->requests.end()) {
+      scheduler->deadlines.erase(scheduler->deadlines.begin());
+      continue;
+    }
+    RequestType type = it->second.type;
+    std::function<void()> cancel = it->second.cancel;
+    scheduler->requestStats[type].timedOut++;
+    scheduler->finish(it);
+    cancel();
+    scheduler->startNext(type);
+  }
+  scheduler->updateTimer();
+}
@@ -0,0 +1,102 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _REQUEST_SCHEDULER_H
+#define _REQUEST_SCHEDULER_H
+
+#include <uv.h>
+#include <stdint.h>
+#include <map>
+#include <deque>
+#include <functional>
+
+enum RequestType {
+  REQUEST_SEARCH = 0,
+  REQUEST_ALBUMBROWSE,
+  REQUEST_ARTISTBROWSE,
+  REQUEST_TYPE_COUNT
+};
+
+enum RequestPriority {
+  PRIORITY_INTERACTIVE = 0,
+  PRIORITY_BACKGROUND,
+  PRIORITY_COUNT
+};
+
+struct RequestStats {
+  int queued[PRIORITY_COUNT];
+  int inFlight;
+  int limit;
+  uint64_t started;
+  uint64_t completed;
+  uint64_t timedOut;
+};
+
+/**
+ * Limits the number of concurrently running libspotify searches and browses per type.
+ * Requests above the limit are queued, interactive ones before background ones.
+ * A request that is not completed before its timeout is cancelled, which must release the libspotify object.
+ * Everything runs in the node.js thread, the scheduler is not thread safe.
+ **/
+class RequestScheduler {
+public:
+  typedef unsigned int RequestId;
+  RequestScheduler();
+  /**
+   * Queue a request. start is called when a slot is free, cancel when the timeout (in ms, 0 for none) is reached.
+   **/
+  RequestId schedule(RequestType type, RequestPriority priority, int timeout, std::function<void()> start, std::function<void()> cancel);
+  /**
+   * Must be called when a started request is done to free its slot.
+   **/
+  void complete(RequestId id);
+  /**
+   * Removes a request without calling cancel, e.g. because its owner is destroyed.
+   **/
+  void remove(RequestId id);
+  void setLimit(RequestType type, int limit);
+  RequestStats stats(RequestType type);
+private:
+  struct Request {
+    RequestType type;
+    RequestPriority priority;
+    uint64_t deadline;
+    bool running;
+    std::function<void()> start;
+    std::function<void()> cancel;
+  };
+  RequestId nextId;
+  std::map<RequestId, Request> requests;
+  //queues can contain ids of removed requests, these are skipped
+  std::deque<RequestId> queues[REQUEST_TYPE_COUNT][PRIORITY_COUNT];
+  std::multimap<uint64_t, RequestId> deadlines;
+  RequestStats requestStats[REQUEST_TYPE_COUNT];
+  uv_timer_t timer;
+  void finish(std::map<RequestId, Request>::iterator it);
+  void startNext(RequestType type);
+  void updateTimer();
+  static void checkTimeouts(uv_timer_t* handle, int status);
+};
+
+#endif
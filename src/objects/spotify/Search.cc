@@ -27,72 +27,110 @@ THE SOFTWARE.
 #include <libspotify/api.h>
 #include "../../Application.h"
 #include "../../callbacks/SearchCallbacks.h"
+#include "../../utils/MemoryUtils.h"
 
 extern Application* application;
 
-Search::Search(const Search& other) : search(other.search) {
+Search::Search(const Search& other) : search(other.search), nodeObject(other.nodeObject), request(0), externalMemory(0) {
   sp_search_add_ref(search);
 };
 
 Search::~Search() {
-  sp_search_release(search);
+  dispose();
 };
 
+/**
+ * Releases the search result and cancels the search if it is queued or running.
+ **/
+void Search::dispose() {
+  if(request != 0) {
+    application->requestScheduler.remove(request);
+    request = 0;
+    searching.release();
+  }
+  if(search != nullptr) {
+    sp_search_release(search);
+    search = nullptr;
+  }
+  cachedLink.clear();
+  MemoryUtils::report(externalMemory, 0);
+}
+
+/**
+ * Reports the estimated size of the search result to V8.
+ **/
+void Search::updateExternalMemory() {
+  int bytes = 0;
+  if(isLoaded()) {
+    int numObjects = sp_search_num_tracks(search) + sp_search_num_albums(search)
+      + sp_search_num_artists(search) + sp_search_num_playlists(search);
+    bytes = numObjects * MemoryUtils::OBJECT_SIZE;
+  }
+  MemoryUtils::report(externalMemory, bytes);
+}
+
+bool Search::isLoaded() {
+  return search != nullptr && sp_search_is_loaded(search);
+}
+
 std::string Search::link() {
-  std::string link;
-  if(sp_search_is_loaded(search)) {
+  if(cachedLink.empty() && isLoaded()) {
     sp_link* spLink = sp_link_create_from_search(search);
     char linkChar[256];
     sp_link_as_string(spLink, linkChar, 256);
-    link = std::string(linkChar);
+    cachedLink = linkChar;
     sp_link_release(spLink);
   }
-  return link;
+  return cachedLink;
 }
 
 std::string Search::didYouMeanText() {
   std::string didYouMeanText;
-  if(sp_search_is_loaded(search)) {
+  if(isLoaded()) {
     didYouMeanText = std::string(sp_search_did_you_mean(search));
   }
   return didYouMeanText;
 }
 
 std::vector<std::shared_ptr<Track>> Search::getTracks() {
-  std::vector<std::shared_ptr<Track>> tracks(sp_search_num_tracks(search));
-  if(sp_search_is_loaded(search)) {
+  std::vector<std::shared_ptr<Track>> tracks;
+  if(isLoaded()) {
+    tracks.resize(sp_search_num_tracks(search));
     for(int i = 0; i < (int)tracks.size() ; ++i) {
-      tracks[i] = std::make_shared<Track>(sp_search_track(search, i));
+      tracks[i] = application->tracks.get(sp_search_track(search, i));
     }
   }
   return tracks;
 }
 
 std::vector<std::shared_ptr<Album>> Search::getAlbums() {
-  std::vector<std::shared_ptr<Album>> albums(sp_search_num_albums(search));
-  if(sp_search_is_loaded(search)) {
+  std::vector<std::shared_ptr<Album>> albums;
+  if(isLoaded()) {
+    albums.resize(sp_search_num_albums(search));
     for(int i = 0; i < (int)albums.size() ; ++i) {
-      albums[i] = std::make_shared<Album>(sp_search_album(search, i));
+      albums[i] = application->albums.get(sp_search_album(search, i));
     }
   }
   return albums;
 }
 
 std::vector<std::shared_ptr<Artist>> Search::getArtists() {
-  std::vector<std::shared_ptr<Artist>> artists(sp_search_num_artists(search));
-  if(sp_search_is_loaded(search)) {
+  std::vector<std::shared_ptr<Artist>> artists;
+  if(isLoaded()) {
+    artists.resize(sp_search_num_artists(search));
     for(int i = 0; i < (int)artists.size() ; ++i) {
-      artists[i] = std::make_shared<Artist>(sp_search_artist(search, i));
+      artists[i] = application->artists.get(sp_search_artist(search, i));
     }
   }
   return artists;
 }
 
 std::vector<std::shared_ptr<Playlist>> Search::getPlaylists() {
-  std::vector<std::shared_ptr<Playlist>> playlists(sp_search_num_playlists(search));
-  if(sp_search_is_loaded(search)) {
+  std::vector<std::shared_ptr<Playlist>> playlists;
+  if(isLoaded()) {
+    playlists.resize(sp_search_num_playlists(search));
     for(int i = 0; i < (int)playlists.size() ; ++i) {
-      playlists[i] = std::make_shared<Playlist>(sp_search_playlist(search, i), -1);
+      playlists[i] = application->playlists.get(sp_search_playlist(search, i), -1);
     }
   }
   return playlists;
@@ -100,7 +138,7 @@ std::vector<std::shared_ptr<Playlist>> Search::getPlaylists() {
 
 int Search::totalTracks() {
   int totalTracks = 0;
-  if(sp_search_is_loaded(search)) {
+  if(isLoaded()) {
     totalTracks = sp_search_total_tracks(search);
   }
   return totalTracks;
@@ -108,7 +146,7 @@ int Search::totalTracks() {
 
 int Search::totalAlbums() {
   int totalAlbums = 0;
-  if(sp_search_is_loaded(search)) {
+  if(isLoaded()) {
     totalAlbums = sp_search_total_albums(search);
   }
   return totalAlbums;
@@ -116,7 +154,7 @@ int Search::totalAlbums() {
 
 int Search::totalArtists() {
   int totalArtists = 0;
-  if(sp_search_is_loaded(search)) {
+  if(isLoaded()) {
     totalArtists = sp_search_total_artists(search);
   }
   return totalArtists;
@@ -124,23 +162,35 @@ int Search::totalArtists() {
 
 int Search::totalPlaylists() {
   int totalPlaylists = 0;
-  if(sp_search_is_loaded(search)) {
+  if(isLoaded()) {
     totalPlaylists = sp_search_total_playlists(search);
   }
   return totalPlaylists;
 }
 
+/**
+ * Queue the search in the request scheduler, sp_search_create is called when a search slot is free.
+ **/
 void Search::execute(std::string query, int trackOffset, int trackLimit,
     int albumOffset, int albumLimit,
     int artistOffset, int artistLimit,
-    int playlistOffset, int playlistLimit) {
-  this->search = sp_search_create(application->session, query.c_str(),
-    trackOffset, trackLimit,
-    albumOffset, albumLimit,
-    artistOffset, artistLimit,
-    playlistOffset, playlistLimit,
-    SP_SEARCH_STANDARD, //?
-    SearchCallbacks::searchComplete,
-    this
+    int playlistOffset, int playlistLimit,
+    RequestPriority priority, int timeout) {
+  request = application->requestScheduler.schedule(REQUEST_SEARCH, priority, timeout,
+    [=]() {
+      search = sp_search_create(application->session, query.c_str(),
+        trackOffset, trackLimit,
+        albumOffset, albumLimit,
+        artistOffset, artistLimit,
+        playlistOffset, playlistLimit,
+        SP_SEARCH_STANDARD, //?
+        SearchCallbacks::searchComplete,
+        this
+      );
+    },
+    [this]() {
+      SearchCallbacks::searchTimeout(this);
+    }
   );
+  searching.hold(nodeObject);
 }
\ No newline at end of file
@@ -35,14 +35,17 @@ THE SOFTWARE.
 #include "Artist.h"
 
 #include "../node/V8Callable.h"
+#include "RequestScheduler.h"
 
 class Search {
 friend class NodeSearch;
 friend class SearchCallbacks;
+friend class JsonSerializer;
 public:
-  Search() {};
+  Search() : search(nullptr), nodeObject(nullptr), request(0), externalMemory(0) {};
   Search(const Search& other);
   ~Search();
+  bool isLoaded();
   std::vector<std::shared_ptr<Track>> getTracks();
   std::vector<std::shared_ptr<Album>> getAlbums();
   std::vector<std::shared_ptr<Artist>> getArtists();
@@ -50,16 +53,25 @@ public:
   void execute(std::string query, int trackOffset, int trackLimit,
     int albumOffset, int albumLimit,
     int artistOffset, int artistLimit,
-    int playlistOffset, int playlistLimit);
+    int playlistOffset, int playlistLimit,
+    RequestPriority priority, int timeout);
   std::string link();
   std::string didYouMeanText();
   int totalTracks();
   int totalAlbums();
   int totalArtists();
   int totalPlaylists();
+  void dispose();
+  void updateExternalMemory();
 private:
+  //taken once the search is loaded
+  std::string cachedLink;
   sp_search* search;
   V8Callable* nodeObject;
+  RequestScheduler::RequestId request;
+  //the Javascript object that waits for the search
+  V8CallableRef searching;
+  int externalMemory;
 };
 
 #endif
\ No newline at end of file
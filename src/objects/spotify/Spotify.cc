@@ -24,18 +24,40 @@ THE SOFTWARE.
 
 #include "Spotify.h"
 #include "../../Application.h"
-#include "../../Callbacks/SessionCallbacks.h"
+#include "../../callbacks/SessionCallbacks.h"
 #include "../../exceptions.h"
 
 #include <fstream>
+#include <uv.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
 extern Application* application;
 static sp_session_config sessionConfig;
 static sp_session_callbacks sessionCallbacks;
 
-Spotify::Spotify(SpotifyOptions options) {
+Spotify::Spotify(SpotifyOptions options) : timeToReady(), nodeObject(nullptr) {
+  timeToReady.sessionCreateStart = uv_hrtime();
   session = createSession(options);
+  timeToReady.sessionCreated = uv_hrtime();
   application->session = session;
+  cacheFolder = options.cacheFolder;
+
+  if(options.cacheSize != -1) {
+    setCacheSize(options.cacheSize);
+  }
+  if(options.preferredBitrate != -1) {
+    setPreferredBitrate(static_cast<sp_bitrate>(options.preferredBitrate));
+  }
+  if(options.preferredOfflineBitrate != -1) {
+    setPreferredOfflineBitrate(static_cast<sp_bitrate>(options.preferredOfflineBitrate), false);
+  }
+  if(options.connectionType != -1) {
+    setConnectionType(static_cast<sp_connection_type>(options.connectionType));
+  }
+  if(options.connectionRules != -1) {
+    setConnectionRules(static_cast<sp_connection_rules>(options.connectionRules));
+  }
 };
 
 sp_session* Spotify::createSession(SpotifyOptions options) {
@@ -60,6 +82,9 @@ sp_session* Spotify::createSession(SpotifyOptions options) {
   sessionCallbacks.logged_out = &SessionCallbacks::loggedOut;
   sessionCallbacks.music_delivery = &SessionCallbacks::music_delivery;
   sessionCallbacks.end_of_track = &SessionCallbacks::end_of_track;
+  sessionCallbacks.credentials_blob_updated = &SessionCallbacks::credentialsBlobUpdated;
+  sessionCallbacks.offline_status_updated = &SessionCallbacks::offlineStatusUpdated;
+  sessionCallbacks.metadata_updated = &SessionCallbacks::metadataUpdated;
 
   sessionConfig.api_version = SPOTIFY_API_VERSION;
   sessionConfig.cache_location = options.cacheFolder.c_str();
@@ -81,6 +106,7 @@ sp_session* Spotify::createSession(SpotifyOptions options) {
 }
 
 void Spotify::login(std::string username, std::string password, bool rememberMe, bool withRemembered) {
+  startLoginTiming();
   if(withRemembered) {
     sp_session_relogin(session);
   } else {
@@ -88,7 +114,25 @@ void Spotify::login(std::string username, std::string password, bool rememberMe,
   }
 }
 
+/**
+ * Login with a credentials blob saved from a previous credentials_blob_updated event.
+ * This skips the password authentication and is the fastest way to get a session.
+ **/
+void Spotify::loginWithCredentialsBlob(std::string username, std::string blob) {
+  startLoginTiming();
+  sp_session_login(session, username.c_str(), NULL, false, blob.c_str());
+}
+
+void Spotify::startLoginTiming() {
+  timeToReady.loginStart = uv_hrtime();
+  timeToReady.loggedIn = 0;
+  timeToReady.playlistContainerLoaded = 0;
+  timeToReady.playlistsLoaded = 0;
+}
+
 void Spotify::logout() {
+  Playlist::failPendingSyncs();
+  application->metadataLoader.failAll();
   application->playlistContainer.reset();
   sp_session_logout(session);
 }
@@ -102,4 +146,82 @@ std::string Spotify::rememberedUser() {
     rememberedUserString = std::string(rememberedUser);
   }
   return rememberedUserString;
-}
\ No newline at end of file
+}
+
+void Spotify::setCacheSize(size_t megabytes) {
+  sp_session_set_cache_size(session, megabytes);
+}
+
+void Spotify::setPreferredBitrate(sp_bitrate bitrate) {
+  sp_session_preferred_bitrate(session, bitrate);
+}
+
+void Spotify::setPreferredOfflineBitrate(sp_bitrate bitrate, bool allowResync) {
+  sp_session_preferred_offline_bitrate(session, bitrate, allowResync);
+}
+
+void Spotify::setConnectionType(sp_connection_type connectionType) {
+  sp_session_set_connection_type(session, connectionType);
+}
+
+void Spotify::setConnectionRules(sp_connection_rules connectionRules) {
+  sp_session_set_connection_rules(session, connectionRules);
+}
+
+static uint64_t directorySize(const std::string& path) {
+  uint64_t size = 0;
+  DIR* dir = opendir(path.c_str());
+  if(dir == nullptr) {
+    return size;
+  }
+  struct dirent* entry;
+  while((entry = readdir(dir)) != nullptr) {
+    std::string name(entry->d_name);
+    if(name == "." || name == "..") {
+      continue;
+    }
+    std::string entryPath = path + "/" + name;
+    struct stat entryStat;
+    if(lstat(entryPath.c_str(), &entryStat) != 0) {
+      continue;
+    }
+    if(S_ISDIR(entryStat.st_mode)) {
+      size += directorySize(entryPath);
+    } else if(S_ISREG(entryStat.st_mode)) {
+      size += entryStat.st_size;
+    }
+  }
+  closedir(dir);
+  return size;
+}
+
+struct CacheUsageWork {
+  uv_work_t request;
+  std::string cacheFolder;
+  uint64_t size;
+  std::function<void(uint64_t size)> done;
+};
+
+static void measureCache(uv_work_t* request) {
+  CacheUsageWork* work = static_cast<CacheUsageWork*>(request->data);
+  work->size = directorySize(work->cacheFolder);
+}
+
+static void cacheMeasured(uv_work_t* request, int status) {
+  CacheUsageWork* work = static_cast<CacheUsageWork*>(request->data);
+  work->done(work->size);
+  delete work;
+}
+
+/**
+ * libspotify does not report the size of its cache, so this sums up the files in the cache folder.
+ * The folder is walked on the libuv thread pool, done is called on the main thread with the size in bytes.
+ **/
+void Spotify::cacheUsage(std::function<void(uint64_t size)> done) {
+  CacheUsageWork* work = new CacheUsageWork();
+  work->request.data = work;
+  work->cacheFolder = cacheFolder;
+  work->size = 0;
+  work->done = done;
+  uv_queue_work(uv_default_loop(), &work->request, &measureCache, &cacheMeasured);
+}
@@ -27,18 +27,48 @@ THE SOFTWARE.
 
 #include <libspotify/api.h>
 #include <string>
+#include <functional>
+#include <stdint.h>
 #include "SpotifyOptions.h"
+#include "../node/V8Callable.h"
+
+/**
+ * Timestamps (uv_hrtime, nanoseconds) of the steps from session creation until all playlists are loaded.
+ * A value of 0 means the step has not been reached yet.
+ **/
+struct TimeToReady {
+  uint64_t sessionCreateStart;
+  uint64_t sessionCreated;
+  uint64_t loginStart;
+  uint64_t loggedIn;
+  uint64_t playlistContainerLoaded;
+  uint64_t playlistsLoaded;
+};
 
 class Spotify {
+friend class NodeSpotify;
+friend class SessionCallbacks;
+friend class PlaylistContainerCallbacks;
 public:
   Spotify(SpotifyOptions options);
   ~Spotify() {};
   void login(std::string user, std::string password, bool remeberedUser, bool withRemembered);
+  void loginWithCredentialsBlob(std::string user, std::string blob);
   void logout();
   std::string rememberedUser();
+  void setCacheSize(size_t megabytes);
+  void setPreferredBitrate(sp_bitrate bitrate);
+  void setPreferredOfflineBitrate(sp_bitrate bitrate, bool allowResync);
+  void setConnectionType(sp_connection_type connectionType);
+  void setConnectionRules(sp_connection_rules connectionRules);
+  void cacheUsage(std::function<void(uint64_t size)> done);
+  TimeToReady timeToReady;
 private:
   sp_session* session;
+  std::string cacheFolder;
+  V8Callable* nodeObject;
   sp_session* createSession(SpotifyOptions options);
+  void startLoginTiming();
 };
 
 #endif
\ No newline at end of file
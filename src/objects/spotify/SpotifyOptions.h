@@ -26,12 +26,23 @@ THE SOFTWARE.
 #define _SPOTIFY_OPTIONS_H
 
 #include <string>
+#include <libspotify/api.h>
 
+/**
+ * Options for the spotify session. Numeric values of -1 mean that the libspotify default is used.
+ **/
 struct SpotifyOptions {
+  SpotifyOptions() : cacheSize(-1), preferredBitrate(-1), preferredOfflineBitrate(-1),
+    connectionType(-1), connectionRules(-1) {};
   std::string settingsFolder;
   std::string cacheFolder;
   std::string traceFile;
   std::string appkeyFile;
+  int cacheSize; //in megabytes, 0 means libspotify manages the size
+  int preferredBitrate; //a sp_bitrate value
+  int preferredOfflineBitrate; //a sp_bitrate value
+  int connectionType; //a sp_connection_type value
+  int connectionRules; //a sp_connection_rules bitmask
 };
 
 #endif
\ No newline at end of file
@@ -25,42 +25,106 @@ THE SOFTWARE.
 #include "Track.h"
 #include "../../Application.h"
 
+#include <algorithm>
+
 extern Application* application;
 
-Track::Track(sp_track* _track) : track(_track) {
+Track::Track(sp_track* _track) : track(_track), nodeObject(nullptr) {
   sp_track_add_ref(track);
 };
 
-std::string Track::name() {
-  std::string name;
-  if(sp_track_is_loaded(track)) {
-    name = std::string(sp_track_name(track));
-  } else {
-    name = "Loading...";
-  }
-  return name;
+bool Track::isLoaded() {
+  return sp_track_is_loaded(track);
 }
 
-std::string Track::link() {
-  std::string link;
-  if(sp_track_is_loaded(track)) {
+/**
+ * Takes the snapshot the first time the track is loaded. Returns nullptr while it is not loaded.
+ * The artists and album are kept as raw pointers, the track holds references to them.
+ **/
+Track::Snapshot* Track::loadSnapshot() {
+  if(!snapshot && sp_track_is_loaded(track)) {
+    snapshot.reset(new Snapshot());
+    snapshot->name = sp_track_name(track);
     sp_link* spLink = sp_link_create_from_track(track, 0);
-    char linkChar[256];
-    sp_link_as_string(spLink, linkChar, 256);
-    link = std::string(linkChar);
-    sp_link_release(spLink);
+    if(spLink != nullptr) {
+      char linkChar[256];
+      sp_link_as_string(spLink, linkChar, 256);
+      snapshot->link = linkChar;
+      sp_link_release(spLink);
+    }
+    snapshot->duration = sp_track_duration(track);
+    int numArtists = sp_track_num_artists(track);
+    snapshot->artists.resize(numArtists);
+    for(int i = 0; i < numArtists; i++) {
+      snapshot->artists[i] = sp_track_artist(track, i);
+    }
+    snapshot->album = sp_track_album(track);
+    snapshot->fuzzyKey = 0;
+  }
+  return snapshot.get();
+}
+
+/**
+ * The track itself as a key for set operations.
+ **/
+uint64_t Track::identityKey() {
+  return reinterpret_cast<uintptr_t>(track);
+}
+
+static uint64_t fnv1a(uint64_t hash, const char* text, bool ignoreCase) {
+  for(; *text != '\0'; text++) {
+    char c = ignoreCase && *text >= 'A' && *text <= 'Z' ? *text - 'A' + 'a' : *text;
+    hash ^= (unsigned char)c;
+    hash *= 0x100000001b3ULL;
+  }
+  //a separator, so that "ab" + "c" and "a" + "bc" differ
+  hash ^= 0xff;
+  hash *= 0x100000001b3ULL;
+  return hash;
+}
+
+/**
+ * A key that is the same for tracks with the same name (ignoring case), artists and duration in seconds,
+ * e.g. a song on an album and on a compilation. It is computed once, until the track and its artists are loaded
+ * the identity key is used.
+ **/
+uint64_t Track::fuzzyKey() {
+  Snapshot* metadata = loadSnapshot();
+  if(metadata == nullptr) {
+    return identityKey();
   }
-  return link;
+  if(metadata->fuzzyKey == 0) {
+    uint64_t hash = fnv1a(0xcbf29ce484222325ULL, metadata->name.c_str(), true);
+    for(auto it = metadata->artists.begin(); it != metadata->artists.end(); it++) {
+      if(*it == nullptr || !sp_artist_is_loaded(*it)) {
+        return identityKey();
+      }
+      hash = fnv1a(hash, sp_artist_name(*it), true);
+    }
+    hash ^= metadata->duration / 1000;
+    hash *= 0x100000001b3ULL;
+    metadata->fuzzyKey = hash != 0 ? hash : 1;
+  }
+  return metadata->fuzzyKey;
+}
+
+std::string Track::name() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->name : "Loading...";
+}
+
+std::string Track::link() {
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->link : std::string();
 }
 
 std::vector<std::shared_ptr<Artist>> Track::artists() {
   std::vector<std::shared_ptr<Artist>> artists;
-  if(sp_track_is_loaded(track)) {
-    int numArtists = sp_track_num_artists(track);
-    artists.resize(numArtists);
-    for(int i = 0; i < numArtists; i++) {
-      sp_artist* spArtist = sp_track_artist(track, i);
-      artists[i] = std::make_shared<Artist>(spArtist);
+  Snapshot* metadata = loadSnapshot();
+  if(metadata != nullptr) {
+    artists.resize(metadata->artists.size());
+    for(int i = 0; i < (int)artists.size(); i++) {
+      artists[i] = application->artists.get(metadata->artists[i]);
     }
   }
   return artists;
@@ -68,19 +132,16 @@ std::vector<std::shared_ptr<Artist>> Track::artists() {
 
 std::shared_ptr<Album> Track::album() {
   std::shared_ptr<Album> album;
-  if(sp_track_is_loaded(track)) {
-    sp_album* spAlbum = sp_track_album(track);
-    album = std::make_shared<Album>(spAlbum);
+  Snapshot* metadata = loadSnapshot();
+  if(metadata != nullptr && metadata->album != nullptr) {
+    album = application->albums.get(metadata->album);
   }
   return album;
 }
 
 int Track::duration() {
-  int duration = -1;
-  if(sp_track_is_loaded(track)) {
-    duration = sp_track_duration(track);
-  }
-  return duration;
+  Snapshot* metadata = loadSnapshot();
+  return metadata != nullptr ? metadata->duration : -1;
 }
 
 bool Track::starred() {
@@ -102,4 +163,32 @@ int Track::popularity() {
 void Track::setStarred(bool starred) {
   //This takes an array of pointers to nodeTracks, so we need to tack the adress of the saved spotifyNodeTrack pointer.
   sp_track_set_starred(application->session, &track, 1, starred);
+}
+
+/**
+ * Stars or unstars all tracks with as few libspotify calls as possible. Loaded tracks that are already
+ * starred (or not) are left out, the rest is passed in chunks of starChunkSize.
+ * The starred playlist gets the changes through its tracks_added and tracks_removed callbacks.
+ * If a chunk fails the chunks before it stay changed, applied is the number of tracks that were changed.
+ **/
+sp_error Track::setStarred(const std::vector<std::shared_ptr<Track>>& tracks, bool starred, int& applied) {
+  static const int starChunkSize = 200;
+  applied = 0;
+  std::vector<sp_track*> changed;
+  changed.reserve(tracks.size());
+  for(auto it = tracks.begin(); it != tracks.end(); it++) {
+    sp_track* spTrack = (*it)->track;
+    if(!sp_track_is_loaded(spTrack) || sp_track_is_starred(application->session, spTrack) != starred) {
+      changed.push_back(spTrack);
+    }
+  }
+  for(size_t offset = 0; offset < changed.size(); offset += starChunkSize) {
+    int chunk = std::min((int)(changed.size() - offset), starChunkSize);
+    sp_error error = sp_track_set_starred(application->session, &changed[offset], chunk, starred);
+    if(error != SP_ERROR_OK) {
+      return error;
+    }
+    applied += chunk;
+  }
+  return SP_ERROR_OK;
 }
\ No newline at end of file
@@ -28,10 +28,12 @@ THE SOFTWARE.
 #include <libspotify/api.h>
 #include <string>
 #include <vector>
+#include <stdint.h>
 #include <memory>
 
 #include "Artist.h"
 #include "Album.h"
+#include "../node/V8Wrapped.h"
 
 class Album;
 class Artist;
@@ -39,15 +41,17 @@ class Artist;
 class Track {
 friend class NodePlayer;
 friend class NodeTrack;
+friend class Playlist;
 public:
   Track(sp_track* _track);
-  Track(const Track& other) : track(other.track) {
+  Track(const Track& other) : track(other.track), nodeObject(nullptr) {
       sp_track_add_ref(track);
     };
   ~Track() {
     sp_track_release(track);
   };
 
+  bool isLoaded();
   std::string name();
   std::string link();
   std::vector<std::shared_ptr<Artist>> artists();
@@ -55,9 +59,26 @@ public:
   int duration();
   bool starred();
   void setStarred(bool starred);
+  static sp_error setStarred(const std::vector<std::shared_ptr<Track>>& tracks, bool starred, int& applied);
   int popularity();
+  uint64_t identityKey();
+  uint64_t fuzzyKey();
 private:
+  /**
+   * Metadata that does not change once the track is loaded. Starred and popularity are not part of it.
+   **/
+  struct Snapshot {
+    std::string name;
+    std::string link;
+    int duration;
+    std::vector<sp_artist*> artists;
+    sp_album* album;
+    uint64_t fuzzyKey; //0 until the artists are loaded
+  };
+  Snapshot* loadSnapshot();
   sp_track* track;
+  V8Wrapped* nodeObject;
+  std::unique_ptr<Snapshot> snapshot;
 };
 
 #endif
@@ -0,0 +1,76 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _TRACK_COLUMNS_H
+#define _TRACK_COLUMNS_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+enum TrackColumn {
+  COLUMN_DURATION = 1 << 0,
+  COLUMN_POPULARITY = 1 << 1,
+  COLUMN_STARRED = 1 << 2,
+  COLUMN_CREATE_TIME = 1 << 3,
+  COLUMN_NAME = 1 << 4,
+  COLUMN_LINK = 1 << 5,
+  COLUMN_ARTIST = 1 << 6,
+  COLUMN_ALBUM = 1 << 7
+};
+
+/**
+ * All strings of a column in one UTF-8 string. String i is data[offsets[i], offsets[i + 1]).
+ **/
+struct StringColumn {
+  std::string data;
+  std::vector<uint32_t> offsets;
+  void add(const char* value) {
+    offsets.push_back(data.size());
+    if(value != nullptr) {
+      data.append(value);
+    }
+  }
+  void finish() {
+    offsets.push_back(data.size());
+  }
+};
+
+/**
+ * Metadata of all tracks of a playlist, one vector per requested column.
+ * Columns that were not requested stay empty. Tracks that are not loaded have zeros and empty strings.
+ **/
+struct TrackColumns {
+  int numTracks;
+  std::vector<uint32_t> duration;
+  std::vector<uint8_t> popularity;
+  std::vector<uint8_t> starred;
+  std::vector<uint32_t> createTime;
+  StringColumn name;
+  StringColumn link;
+  StringColumn artist;
+  StringColumn album;
+};
+
+#endif
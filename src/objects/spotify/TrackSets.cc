@@ -0,0 +1,89 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "TrackSets.h"
+#include "../../utils/OpenHashSet.h"
+
+static std::vector<uint64_t> keys(const std::vector<std::shared_ptr<Track>>& tracks, bool fuzzy) {
+  std::vector<uint64_t> trackKeys(tracks.size());
+  for(size_t i = 0; i < tracks.size(); i++) {
+    trackKeys[i] = fuzzy ? tracks[i]->fuzzyKey() : tracks[i]->identityKey();
+  }
+  return trackKeys;
+}
+
+static OpenHashSet toSet(const std::vector<uint64_t>& trackKeys) {
+  OpenHashSet set(trackKeys.size());
+  for(auto it = trackKeys.begin(); it != trackKeys.end(); it++) {
+    set.insert(*it);
+  }
+  return set;
+}
+
+/**
+ * The first position of every key in a whose membership in b equals inB.
+ **/
+static std::vector<uint32_t> select(const std::vector<uint64_t>& a, const OpenHashSet& b, bool inB) {
+  std::vector<uint32_t> positions;
+  OpenHashSet taken(a.size());
+  for(size_t i = 0; i < a.size(); i++) {
+    if(b.contains(a[i]) == inB && taken.insert(a[i])) {
+      positions.push_back(i);
+    }
+  }
+  return positions;
+}
+
+TrackSets::Selection TrackSets::intersect(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy) {
+  Selection selection;
+  selection.a = select(keys(a, fuzzy), toSet(keys(b, fuzzy)), true);
+  return selection;
+}
+
+TrackSets::Selection TrackSets::difference(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy) {
+  Selection selection;
+  selection.a = select(keys(a, fuzzy), toSet(keys(b, fuzzy)), false);
+  return selection;
+}
+
+TrackSets::Selection TrackSets::unite(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy) {
+  Selection selection;
+  std::vector<uint64_t> keysA = keys(a, fuzzy);
+  OpenHashSet setA = toSet(keysA);
+  selection.a = select(keysA, OpenHashSet(0), false);
+  selection.b = select(keys(b, fuzzy), setA, false);
+  return selection;
+}
+
+std::vector<uint32_t> TrackSets::duplicates(const std::vector<std::shared_ptr<Track>>& a, bool fuzzy) {
+  std::vector<uint64_t> keysA = keys(a, fuzzy);
+  std::vector<uint32_t> positions;
+  OpenHashSet seen(keysA.size());
+  for(size_t i = 0; i < keysA.size(); i++) {
+    if(!seen.insert(keysA[i])) {
+      positions.push_back(i);
+    }
+  }
+  return positions;
+}
@@ -0,0 +1,55 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _TRACK_SETS_H
+#define _TRACK_SETS_H
+
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+#include "Track.h"
+
+/**
+ * Set operations on lists of tracks, e.g. the tracks of two playlists. Tracks are compared by their key
+ * (Track::identityKey or with fuzzy Track::fuzzyKey) in an OpenHashSet.
+ * The results are positions in the lists, a track that is in a list more than once is only taken the first time.
+ **/
+namespace TrackSets {
+  struct Selection {
+    std::vector<uint32_t> a;
+    std::vector<uint32_t> b;
+  };
+
+  //tracks of a that are in b
+  Selection intersect(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy);
+  //tracks of a that are not in b
+  Selection difference(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy);
+  //tracks of a, then the tracks of b that are not in a
+  Selection unite(const std::vector<std::shared_ptr<Track>>& a, const std::vector<std::shared_ptr<Track>>& b, bool fuzzy);
+  //positions in a of tracks that were in a before, for removing duplicates
+  std::vector<uint32_t> duplicates(const std::vector<std::shared_ptr<Track>>& a, bool fuzzy);
+}
+
+#endif
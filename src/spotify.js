@@ -24,12 +24,55 @@ THE SOFTWARE.
 
 var _spotify = require('./nodespotify');
 
+/**
+ * Asynchronous methods (ready, browse, execute) return a promise if they are called without a callback.
+ * The promise implementation is global.Promise or the Promise given in the options, spotify.usePromise can change it later.
+ **/
+function usePromise(spotify, Promise) {
+  spotify.setPromiseFactory(function() {
+    var deferred = {};
+    deferred.promise = new Promise(function(resolve, reject) {
+      deferred.callback = function(err, result) {
+        if(err) {
+          reject(err);
+        } else {
+          resolve(result);
+        }
+      };
+    });
+    return deferred;
+  });
+}
+
 var beefedupSpotify = function(options) {
   var spotify = _spotify(options);
+  var Promise = (options && options.Promise) || global.Promise;
+  if(Promise) {
+    usePromise(spotify, Promise);
+  }
+  spotify.usePromise = function(Promise) {
+    usePromise(spotify, Promise);
+  };
   spotify.version = '0.4.0';
   spotify.ARTISTBROWSE_FULL = 0;
   spotify.ARTISTBROWSE_NO_TRACKS = 1;
   spotify.ARTISTBROWSE_NO_ALBUMS = 2;
+  spotify.CONNECTION_TYPE_UNKNOWN = 0;
+  spotify.CONNECTION_TYPE_NONE = 1;
+  spotify.CONNECTION_TYPE_MOBILE = 2;
+  spotify.CONNECTION_TYPE_MOBILE_ROAMING = 3;
+  spotify.CONNECTION_TYPE_WIFI = 4;
+  spotify.CONNECTION_TYPE_WIRED = 5;
+  spotify.CONNECTION_RULE_NETWORK = 0x1;
+  spotify.CONNECTION_RULE_NETWORK_IF_ROAMING = 0x2;
+  spotify.CONNECTION_RULE_ALLOW_SYNC_OVER_MOBILE = 0x4;
+  spotify.CONNECTION_RULE_ALLOW_SYNC_OVER_WIFI = 0x8;
+  spotify.PLAYLIST_OFFLINE_STATUS_NO = 0;
+  spotify.PLAYLIST_OFFLINE_STATUS_YES = 1;
+  spotify.PLAYLIST_OFFLINE_STATUS_DOWNLOADING = 2;
+  spotify.PLAYLIST_OFFLINE_STATUS_WAITING = 3;
+  spotify.PRIORITY_INTERACTIVE = 0;
+  spotify.PRIORITY_BACKGROUND = 1;
   return spotify;
 }
 
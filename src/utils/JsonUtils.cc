@@ -0,0 +1,57 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "JsonUtils.h"
+#include "Symbols.h"
+#include "../objects/node/NodeTrack.h"
+
+#include <node_buffer.h>
+
+namespace JsonUtils {
+  static const int defaultDepth = 1;
+
+  v8::Handle<v8::Value> toJSON(const v8::Arguments& args, Serializer serializer) {
+    v8::HandleScope scope;
+    bool fromStringify = args[0]->IsString();
+    int depth = args[0]->IsNumber() ? args[0]->IntegerValue() : defaultDepth;
+    int trackFields = NodeTrack::parseFields(fromStringify ? v8::Handle<v8::Value>(v8::Undefined()) : args[1]);
+    if(trackFields == -1) {
+      return scope.Close(v8::ThrowException(v8::Exception::Error(v8::String::New("Unknown track field"))));
+    }
+    JsonWriter writer;
+    serializer(writer, depth, trackFields);
+    const std::string& json = writer.str();
+    if(fromStringify) {
+      v8::Local<v8::Object> JSON = v8::Context::GetCurrent()->Global()->Get(Symbols::JSON)->ToObject();
+      v8::Local<v8::Function> parse = v8::Local<v8::Function>::Cast(JSON->Get(Symbols::parse));
+      v8::Handle<v8::Value> argv[] = { v8::String::New(json.data(), json.size()) };
+      return scope.Close(parse->Call(JSON, 1, argv));
+    }
+    if(args[2]->IsTrue()) {
+      node::Buffer* buffer = node::Buffer::New(json.data(), json.size());
+      return scope.Close(buffer->handle_);
+    }
+    return scope.Close(v8::String::New(json.data(), json.size()));
+  }
+}
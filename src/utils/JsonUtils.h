@@ -0,0 +1,46 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _JSON_UTILS_H
+#define _JSON_UTILS_H
+
+#include <v8.h>
+#include <functional>
+
+#include "JsonWriter.h"
+
+/**
+ * toJSON(depth, fields, asBuffer) of playlists, albums, artists and searches.
+ **/
+namespace JsonUtils {
+  typedef std::function<void(JsonWriter& writer, int depth, int trackFields)> Serializer;
+  /**
+   * Parses the arguments, calls serializer and returns the JSON as a string or, if asBuffer is true, as a Buffer.
+   * JSON.stringify calls toJSON with a key string as the first argument, in that case the parsed object is
+   * returned so that JSON.stringify(playlist) gives the same JSON.
+   **/
+  v8::Handle<v8::Value> toJSON(const v8::Arguments& args, Serializer serializer);
+}
+
+#endif
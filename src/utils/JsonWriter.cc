@@ -0,0 +1,145 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "JsonWriter.h"
+
+#include <string.h>
+#include <stdio.h>
+
+JsonWriter::JsonWriter(size_t initialCapacity) : afterKey(false) {
+  buffer.reserve(initialCapacity);
+}
+
+void JsonWriter::separate() {
+  if(afterKey) {
+    afterKey = false;
+  } else if(!first.empty()) {
+    if(!first.back()) {
+      buffer.push_back(',');
+    }
+    first.back() = false;
+  }
+}
+
+void JsonWriter::beginObject() {
+  separate();
+  buffer.push_back('{');
+  first.push_back(true);
+}
+
+void JsonWriter::endObject() {
+  buffer.push_back('}');
+  first.pop_back();
+}
+
+void JsonWriter::beginArray() {
+  separate();
+  buffer.push_back('[');
+  first.push_back(true);
+}
+
+void JsonWriter::endArray() {
+  buffer.push_back(']');
+  first.pop_back();
+}
+
+void JsonWriter::key(const char* name) {
+  separate();
+  writeString(name, strlen(name));
+  buffer.push_back(':');
+  afterKey = true;
+}
+
+void JsonWriter::string(const char* value) {
+  separate();
+  if(value == nullptr) {
+    buffer.append("null");
+  } else {
+    writeString(value, strlen(value));
+  }
+}
+
+void JsonWriter::string(const std::string& value) {
+  separate();
+  writeString(value.data(), value.size());
+}
+
+void JsonWriter::number(int64_t value) {
+  separate();
+  char number[24];
+  int length = snprintf(number, sizeof(number), "%lld", (long long)value);
+  buffer.append(number, length);
+}
+
+void JsonWriter::boolean(bool value) {
+  separate();
+  buffer.append(value ? "true" : "false");
+}
+
+void JsonWriter::null() {
+  separate();
+  buffer.append("null");
+}
+
+/**
+ * Copies runs of characters that need no escaping in one append. libspotify strings are UTF-8,
+ * so only quotes, backslashes and control characters have to be escaped.
+ **/
+void JsonWriter::writeString(const char* value, size_t length) {
+  static const char hex[] = "0123456789abcdef";
+  buffer.push_back('"');
+  size_t runStart = 0;
+  for(size_t i = 0; i < length; i++) {
+    unsigned char c = value[i];
+    if(c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    buffer.append(value + runStart, i - runStart);
+    runStart = i + 1;
+    switch(c) {
+      case '"':
+        buffer.append("\\\"");
+        break;
+      case '\\':
+        buffer.append("\\\\");
+        break;
+      case '\n':
+        buffer.append("\\n");
+        break;
+      case '\r':
+        buffer.append("\\r");
+        break;
+      case '\t':
+        buffer.append("\\t");
+        break;
+      default:
+      {
+        char escaped[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+        buffer.append(escaped, sizeof(escaped));
+      }
+    }
+  }
+  buffer.append(value + runStart, length - runStart);
+  buffer.push_back('"');
+}
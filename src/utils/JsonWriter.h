@@ -0,0 +1,61 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _JSON_WRITER_H
+#define _JSON_WRITER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Writes JSON into a growing string. Commas and colons are inserted automatically:
+ *   writer.beginObject(); writer.key("name"); writer.string("x"); writer.endObject();
+ **/
+class JsonWriter {
+public:
+  JsonWriter(size_t initialCapacity = 4096);
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+  void key(const char* name);
+  void string(const char* value);
+  void string(const std::string& value);
+  void number(int64_t value);
+  void boolean(bool value);
+  void null();
+  const std::string& str() {
+    return buffer;
+  }
+private:
+  std::string buffer;
+  //one entry per open object or array, true as long as nothing has been written into it
+  std::vector<bool> first;
+  bool afterKey;
+  void separate();
+  void writeString(const char* value, size_t length);
+};
+
+#endif
@@ -0,0 +1,45 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _MEMORY_UTILS_H
+#define _MEMORY_UTILS_H
+
+#include <v8.h>
+
+/**
+ * V8 does not see the memory libspotify holds for browse results, searches and images, so
+ * a few Javascript wrappers can keep a lot of native memory alive without triggering a GC.
+ * Objects holding such memory report an estimate of it.
+ **/
+namespace MemoryUtils {
+  //Estimated native size of one track, album, artist or playlist in a browse or search result.
+  const int OBJECT_SIZE = 256;
+
+  /**
+   * Adjusts the memory V8 knows about from reported to bytes and sets reported to bytes.
+   **/
+  void report(int& reported, int bytes);
+}
+
+#endif
@@ -0,0 +1,109 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _OPEN_HASH_SET_H
+#define _OPEN_HASH_SET_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A set of 64 bit keys with open addressing and linear probing in one flat array, for set operations on
+ * many tracks without a node allocation per key. The key 0 marks an empty slot and must not be inserted.
+ **/
+class OpenHashSet {
+public:
+  /**
+   * Reserves room for expected keys, the set grows if more are inserted.
+   **/
+  explicit OpenHashSet(size_t expected) : count(0) {
+    size_t capacity = 16;
+    while(capacity < expected * 2) {
+      capacity *= 2;
+    }
+    slots.resize(capacity, 0);
+  }
+
+  /**
+   * Returns true if the key was not in the set before.
+   **/
+  bool insert(uint64_t key) {
+    if((count + 1) * 2 > slots.size()) {
+      grow();
+    }
+    size_t slot = find(key);
+    if(slots[slot] == key) {
+      return false;
+    }
+    slots[slot] = key;
+    count++;
+    return true;
+  }
+
+  bool contains(uint64_t key) const {
+    return slots[find(key)] == key;
+  }
+
+  size_t size() const {
+    return count;
+  }
+private:
+  /**
+   * The slot of key or the empty slot where it would be inserted.
+   **/
+  size_t find(uint64_t key) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = mix(key) & mask;
+    while(slots[slot] != 0 && slots[slot] != key) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  //Pointers have their low bits in common, the finalizer of MurmurHash3 spreads them over all bits
+  static uint64_t mix(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  void grow() {
+    std::vector<uint64_t> old(slots.size() * 2, 0);
+    old.swap(slots);
+    for(auto it = old.begin(); it != old.end(); it++) {
+      if(*it != 0) {
+        slots[find(*it)] = *it;
+      }
+    }
+  }
+
+  std::vector<uint64_t> slots;
+  size_t count;
+};
+
+#endif
@@ -0,0 +1,66 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _PERSISTENT_UTILS_H
+#define _PERSISTENT_UTILS_H
+
+#include <v8.h>
+
+/**
+ * All persistent handles for callbacks and pending results are created and disposed through these functions.
+ * They count the live handles, spotify.getLiveHandleCount() returns the count to find leaks in long running processes.
+ * The handles of constructors and symbols live as long as the module and are not counted.
+ **/
+namespace PersistentUtils {
+  extern int liveHandles;
+
+  template <class T>
+  v8::Persistent<T> create(v8::Handle<T> handle) {
+    liveHandles++;
+    return v8::Persistent<T>::New(handle);
+  }
+
+  /**
+   * Disposes and clears the handle. Does nothing if it is empty.
+   **/
+  template <class T>
+  void dispose(v8::Persistent<T>& handle) {
+    if(!handle.IsEmpty()) {
+      handle.Dispose();
+      handle.Clear();
+      liveHandles--;
+    }
+  }
+
+  /**
+   * Disposes the handle and replaces it with a new one for value.
+   **/
+  template <class T>
+  void reset(v8::Persistent<T>& handle, v8::Handle<T> value) {
+    dispose(handle);
+    handle = create(value);
+  }
+}
+
+#endif
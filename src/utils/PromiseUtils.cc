@@ -0,0 +1,50 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "PromiseUtils.h"
+#include "Symbols.h"
+#include "PersistentUtils.h"
+
+namespace PromiseUtils {
+  static v8::Persistent<v8::Function> promiseFactory;
+
+  void setFactory(v8::Handle<v8::Function> factory) {
+    PersistentUtils::reset(promiseFactory, factory);
+  }
+
+  //The handles are created in the HandleScope of the calling method.
+  v8::Handle<v8::Value> callbackOrPromise(v8::Handle<v8::Value> argument, v8::Handle<v8::Function>& callback) {
+    if(argument->IsFunction()) {
+      callback = v8::Handle<v8::Function>::Cast(argument);
+      return v8::Undefined();
+    }
+    if(promiseFactory.IsEmpty()) {
+      return v8::Undefined();
+    }
+    //The factory returns { promise: ..., callback: function(error, result) }
+    v8::Local<v8::Object> deferred = promiseFactory->Call(v8::Context::GetCurrent()->Global(), 0, NULL)->ToObject();
+    callback = v8::Handle<v8::Function>::Cast(deferred->Get(Symbols::callback));
+    return deferred->Get(Symbols::promise);
+  }
+}
@@ -0,0 +1,45 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _PROMISE_UTILS_H
+#define _PROMISE_UTILS_H
+
+#include <v8.h>
+
+/**
+ * Asynchronous methods take a node style callback(error, result) as their last argument.
+ * If no callback is given and a promise factory has been set from Javascript (see spotify.js)
+ * a promise is returned instead.
+ **/
+namespace PromiseUtils {
+  void setFactory(v8::Handle<v8::Function> factory);
+  /**
+   * If argument is a function it is used as the callback and undefined is returned.
+   * Otherwise a new promise is created, callback is set to the function that settles it
+   * and the promise is returned. Without a factory callback stays empty.
+   **/
+  v8::Handle<v8::Value> callbackOrPromise(v8::Handle<v8::Value> argument, v8::Handle<v8::Function>& callback);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "RequestUtils.h"
+#include "Symbols.h"
+
+namespace RequestUtils {
+  v8::Handle<v8::Value> optionsArgument(const v8::Arguments& args, int index) {
+    v8::Handle<v8::Value> callbackArgument = args[index - 1];
+    if(callbackArgument->IsObject() && !callbackArgument->IsFunction()) {
+      return callbackArgument;
+    }
+    return args[index];
+  }
+
+  RequestOptions parseOptions(v8::Handle<v8::Value> options) {
+    RequestOptions requestOptions;
+    requestOptions.priority = PRIORITY_INTERACTIVE;
+    requestOptions.timeout = 0;
+    if(options->IsObject()) {
+      v8::Handle<v8::Object> optionsObject = options->ToObject();
+      v8::Handle<v8::Value> priority = optionsObject->Get(Symbols::priority);
+      v8::Handle<v8::Value> timeout = optionsObject->Get(Symbols::timeout);
+      if(priority->IsNumber() && priority->IntegerValue() == PRIORITY_BACKGROUND) {
+        requestOptions.priority = PRIORITY_BACKGROUND;
+      }
+      if(timeout->IsNumber() && timeout->IntegerValue() > 0) {
+        requestOptions.timeout = timeout->IntegerValue();
+      }
+    }
+    return requestOptions;
+  }
+}
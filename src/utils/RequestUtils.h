@@ -0,0 +1,51 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _REQUEST_UTILS_H
+#define _REQUEST_UTILS_H
+
+#include <v8.h>
+#include "../objects/spotify/RequestScheduler.h"
+
+struct RequestOptions {
+  RequestPriority priority;
+  int timeout;
+};
+
+/**
+ * search.execute, album.browse and artist.browse take an optional options object { priority, timeout }
+ * after the callback. It may also take the place of the callback when a promise is wanted.
+ **/
+namespace RequestUtils {
+  /**
+   * Returns the options argument: args[index] or args[index - 1] if that is an object but no function.
+   **/
+  v8::Handle<v8::Value> optionsArgument(const v8::Arguments& args, int index);
+  /**
+   * Defaults are interactive priority and no timeout.
+   **/
+  RequestOptions parseOptions(v8::Handle<v8::Value> options);
+}
+
+#endif
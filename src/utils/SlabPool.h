@@ -0,0 +1,158 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _SLAB_POOL_H
+#define _SLAB_POOL_H
+
+#include <stddef.h>
+#include <vector>
+#include <new>
+#include <utility>
+
+/**
+ * Hands out blocks of Size bytes from slabs of BlocksPerSlab blocks. Freed blocks are kept in a free list and reused,
+ * slabs are only given back to the system when the process exits. There is one pool per block size.
+ * Not thread safe, all objects are created and destroyed in the node thread.
+ **/
+template <size_t Size, size_t BlocksPerSlab = 512>
+class SlabPool {
+public:
+  static void* allocate() {
+    if(freeList == nullptr) {
+      addSlab();
+    }
+    Block* block = freeList;
+    freeList = block->next;
+    usedBlocks++;
+    return block;
+  }
+
+  static void deallocate(void* pointer) {
+    Block* block = static_cast<Block*>(pointer);
+    block->next = freeList;
+    freeList = block;
+    usedBlocks--;
+  }
+
+  static size_t used() {
+    return usedBlocks;
+  }
+
+  static size_t capacity() {
+    return slabs.size() * BlocksPerSlab;
+  }
+private:
+  union Block {
+    Block* next;
+    char data[Size];
+    //for the alignment
+    long double alignLongDouble;
+    long long alignLongLong;
+    void* alignPointer;
+  };
+
+  static void addSlab() {
+    Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * BlocksPerSlab));
+    slabs.push_back(slab);
+    for(size_t i = 0; i < BlocksPerSlab; i++) {
+      slab[i].next = freeList;
+      freeList = &slab[i];
+    }
+  }
+
+  static Block* freeList;
+  static size_t usedBlocks;
+  static std::vector<Block*> slabs;
+};
+
+template <size_t Size, size_t BlocksPerSlab> typename SlabPool<Size, BlocksPerSlab>::Block* SlabPool<Size, BlocksPerSlab>::freeList = nullptr;
+template <size_t Size, size_t BlocksPerSlab> size_t SlabPool<Size, BlocksPerSlab>::usedBlocks = 0;
+template <size_t Size, size_t BlocksPerSlab> std::vector<typename SlabPool<Size, BlocksPerSlab>::Block*> SlabPool<Size, BlocksPerSlab>::slabs;
+
+/**
+ * A standard allocator that takes single objects from the SlabPool of their size,
+ * e.g. for the nodes of a std::map or the control block of a std::shared_ptr.
+ **/
+template <class T>
+class PoolAllocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  template <class U> struct rebind {
+    typedef PoolAllocator<U> other;
+  };
+
+  PoolAllocator() {}
+  template <class U> PoolAllocator(const PoolAllocator<U>&) {}
+
+  T* allocate(size_t n, const void* = 0) {
+    if(n == 1) {
+      return static_cast<T*>(SlabPool<sizeof(T)>::allocate());
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, size_t n) {
+    if(n == 1) {
+      SlabPool<sizeof(T)>::deallocate(pointer);
+    } else {
+      ::operator delete(pointer);
+    }
+  }
+
+  template <class U, class... Args> void construct(U* pointer, Args&&... args) {
+    ::new((void*)pointer) U(std::forward<Args>(args)...);
+  }
+
+  template <class U> void destroy(U* pointer) {
+    pointer->~U();
+  }
+
+  T* address(T& value) const {
+    return &value;
+  }
+
+  const T* address(const T& value) const {
+    return &value;
+  }
+
+  size_t max_size() const {
+    return size_t(-1) / sizeof(T);
+  }
+};
+
+template <class T, class U> bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+  return true;
+}
+
+template <class T, class U> bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+  return false;
+}
+
+#endif
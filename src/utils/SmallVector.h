@@ -0,0 +1,100 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _SMALL_VECTOR_H
+#define _SMALL_VECTOR_H
+
+/**
+ * A vector that stores up to N items inline and only allocates when it grows beyond that.
+ * Meant for small, cheap to copy items like handles, the items are copied with operator=.
+ **/
+template <class T, int N>
+class SmallVector {
+public:
+  SmallVector() : count(0), capacity(N), items(inlineItems) {}
+  ~SmallVector() {
+    if(items != inlineItems) {
+      delete[] items;
+    }
+  }
+
+  int size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  T& operator[](int index) {
+    return items[index];
+  }
+
+  void push_back(const T& item) {
+    if(count == capacity) {
+      grow();
+    }
+    items[count++] = item;
+  }
+
+  /**
+   * Removes the item at index, the order of the other items is kept.
+   **/
+  void erase(int index) {
+    for(int i = index; i < count - 1; i++) {
+      items[i] = items[i + 1];
+    }
+    count--;
+  }
+
+  void pop_back() {
+    count--;
+  }
+
+  void clear() {
+    count = 0;
+  }
+private:
+  SmallVector(const SmallVector& other);
+  SmallVector& operator=(const SmallVector& other);
+
+  void grow() {
+    T* grown = new T[capacity * 2];
+    for(int i = 0; i < count; i++) {
+      grown[i] = items[i];
+    }
+    if(items != inlineItems) {
+      delete[] items;
+    }
+    items = grown;
+    capacity *= 2;
+  }
+
+  int count;
+  int capacity;
+  T* items;
+  T inlineItems[N];
+};
+
+#endif
@@ -0,0 +1,63 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "Symbols.h"
+
+namespace Symbols {
+#define DEFINE_SYMBOL(name) v8::Persistent<v8::String> name;
+  SYMBOLS(DEFINE_SYMBOL)
+#undef DEFINE_SYMBOL
+  v8::Persistent<v8::String> events[EVENT_COUNT];
+
+  static const char* eventNames[EVENT_COUNT] = {
+#define EVENT_NAME(id, name) name,
+    EVENTS(EVENT_NAME)
+#undef EVENT_NAME
+  };
+
+  void init() {
+    if(!events[0].IsEmpty()) {
+      return;
+    }
+#define CREATE_SYMBOL(name) name = v8::Persistent<v8::String>::New(v8::String::NewSymbol(#name));
+    SYMBOLS(CREATE_SYMBOL)
+#undef CREATE_SYMBOL
+    for(int i = 0; i < EVENT_COUNT; i++) {
+      events[i] = v8::Persistent<v8::String>::New(v8::String::NewSymbol(eventNames[i]));
+    }
+  }
+
+  int eventId(v8::Handle<v8::Value> name) {
+    if(!name->IsString()) {
+      return -1;
+    }
+    //String literals from Javascript are symbols too, so this is mostly a pointer comparison.
+    for(int i = 0; i < EVENT_COUNT; i++) {
+      if(events[i]->StrictEquals(name)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+}
@@ -0,0 +1,133 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _SYMBOLS_H
+#define _SYMBOLS_H
+
+#include <v8.h>
+
+#include "../events.h"
+
+/**
+ * Property names used outside of the init methods.
+ **/
+#define SYMBOLS(SYMBOL) \
+  SYMBOL(settingsFolder) \
+  SYMBOL(cacheFolder) \
+  SYMBOL(traceFile) \
+  SYMBOL(appkeyFile) \
+  SYMBOL(cacheSize) \
+  SYMBOL(bitrate) \
+  SYMBOL(offlineBitrate) \
+  SYMBOL(connectionType) \
+  SYMBOL(connectionRules) \
+  SYMBOL(priority) \
+  SYMBOL(timeout) \
+  SYMBOL(waitForLoad) \
+  SYMBOL(batch) \
+  SYMBOL(callback) \
+  SYMBOL(promise) \
+  SYMBOL(JSON) \
+  SYMBOL(parse) \
+  SYMBOL(objects) \
+  SYMBOL(errors) \
+  SYMBOL(index) \
+  SYMBOL(link) \
+  SYMBOL(message) \
+  SYMBOL(name) \
+  SYMBOL(length) \
+  SYMBOL(data) \
+  SYMBOL(offsets) \
+  SYMBOL(indices) \
+  SYMBOL(artists) \
+  SYMBOL(albums) \
+  SYMBOL(artist) \
+  SYMBOL(album) \
+  SYMBOL(duration) \
+  SYMBOL(popularity) \
+  SYMBOL(starred) \
+  SYMBOL(createTime) \
+  SYMBOL(syncing) \
+  SYMBOL(queuedTracks) \
+  SYMBOL(queuedBytes) \
+  SYMBOL(doneTracks) \
+  SYMBOL(doneBytes) \
+  SYMBOL(copiedTracks) \
+  SYMBOL(copiedBytes) \
+  SYMBOL(willNotCopyTracks) \
+  SYMBOL(errorTracks) \
+  SYMBOL(tracksToSync) \
+  SYMBOL(offlinePlaylists) \
+  SYMBOL(timeLeft) \
+  SYMBOL(queuedInteractive) \
+  SYMBOL(queuedBackground) \
+  SYMBOL(inFlight) \
+  SYMBOL(limit) \
+  SYMBOL(started) \
+  SYMBOL(completed) \
+  SYMBOL(timedOut) \
+  SYMBOL(sessionCreate) \
+  SYMBOL(login) \
+  SYMBOL(playlistContainer) \
+  SYMBOL(playlists) \
+  SYMBOL(total) \
+  SYMBOL(playlist) \
+  SYMBOL(type) \
+  SYMBOL(position) \
+  SYMBOL(count) \
+  SYMBOL(done) \
+  SYMBOL(add) \
+  SYMBOL(remove) \
+  SYMBOL(move) \
+  SYMBOL(update) \
+  SYMBOL(id) \
+  SYMBOL(newPosition) \
+  SYMBOL(folder) \
+  SYMBOL(children) \
+  SYMBOL(fuzzy) \
+  SYMBOL(a) \
+  SYMBOL(b) \
+  SYMBOL(applied)
+
+/**
+ * Interned strings that are created once, so hot paths don't hash the same property and event names over and over.
+ * Use them like options->Get(Symbols::timeout).
+ **/
+namespace Symbols {
+#define DECLARE_SYMBOL(name) extern v8::Persistent<v8::String> name;
+  SYMBOLS(DECLARE_SYMBOL)
+#undef DECLARE_SYMBOL
+  extern v8::Persistent<v8::String> events[EVENT_COUNT];
+
+  /**
+   * Must be called before any of the symbols is used.
+   **/
+  void init();
+  /**
+   * Returns the event with the given name or -1 if there is none.
+   **/
+  int eventId(v8::Handle<v8::Value> name);
+}
+
+#endif
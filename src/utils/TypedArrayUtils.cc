@@ -0,0 +1,80 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "TypedArrayUtils.h"
+#include <string.h>
+
+namespace TypedArrayUtils {
+  //The handles are created in the HandleScope of the calling method.
+  v8::Handle<v8::Object> newTypedArray(const char* type, int length, void** data) {
+    v8::Local<v8::Function> constructor = v8::Local<v8::Function>::Cast(v8::Context::GetCurrent()->Global()->Get(v8::String::NewSymbol(type)));
+    v8::Handle<v8::Value> argv[] = { v8::Integer::New(length) };
+    v8::Local<v8::Object> array = constructor->NewInstance(1, argv);
+    *data = array->GetIndexedPropertiesExternalArrayData();
+    return array;
+  }
+
+  v8::Handle<v8::Object> fromVector(const std::vector<uint8_t>& values) {
+    void* data;
+    v8::Handle<v8::Object> array = newTypedArray("Uint8Array", values.size(), &data);
+    if(!values.empty()) {
+      memcpy(data, &values[0], values.size() * sizeof(uint8_t));
+    }
+    return array;
+  }
+
+  v8::Handle<v8::Object> fromVector(const std::vector<uint32_t>& values) {
+    void* data;
+    v8::Handle<v8::Object> array = newTypedArray("Uint32Array", values.size(), &data);
+    if(!values.empty()) {
+      memcpy(data, &values[0], values.size() * sizeof(uint32_t));
+    }
+    return array;
+  }
+
+  v8::Handle<v8::Object> fromVector(const std::vector<int32_t>& values) {
+    void* data;
+    v8::Handle<v8::Object> array = newTypedArray("Int32Array", values.size(), &data);
+    if(!values.empty()) {
+      memcpy(data, &values[0], values.size() * sizeof(int32_t));
+    }
+    return array;
+  }
+
+  bool toVector(v8::Handle<v8::Value> value, std::vector<int32_t>& values) {
+    if(!value->IsObject() || !value->ToObject()->HasIndexedPropertiesInExternalArrayData()) {
+      return false;
+    }
+    v8::Handle<v8::Object> array = value->ToObject();
+    v8::ExternalArrayType type = array->GetIndexedPropertiesExternalArrayDataType();
+    if(type != v8::kExternalIntArray && type != v8::kExternalUnsignedIntArray) {
+      return false;
+    }
+    values.resize(array->GetIndexedPropertiesExternalArrayDataLength());
+    if(!values.empty()) {
+      memcpy(&values[0], array->GetIndexedPropertiesExternalArrayData(), values.size() * sizeof(int32_t));
+    }
+    return true;
+  }
+}
@@ -0,0 +1,49 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) <2013> <Moritz Schulze>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#ifndef _TYPED_ARRAY_UTILS_H
+#define _TYPED_ARRAY_UTILS_H
+
+#include <v8.h>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * V8 has no API to create typed arrays, so the global constructors (Uint32Array, ...) are used.
+ **/
+namespace TypedArrayUtils {
+  /**
+   * Creates a zero filled typed array, e.g. newTypedArray("Uint32Array", 10), and sets data to its memory.
+   **/
+  v8::Handle<v8::Object> newTypedArray(const char* type, int length, void** data);
+  v8::Handle<v8::Object> fromVector(const std::vector<uint8_t>& values);
+  v8::Handle<v8::Object> fromVector(const std::vector<uint32_t>& values);
+  v8::Handle<v8::Object> fromVector(const std::vector<int32_t>& values);
+  /**
+   * Copies an Int32Array or Uint32Array into values. Returns false if value is no such array.
+   **/
+  bool toVector(v8::Handle<v8::Value> value, std::vector<int32_t>& values);
+}
+
+#endif
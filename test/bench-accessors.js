@@ -0,0 +1,81 @@
+/**
+ * Measures reading album.name at a call site that sees one hidden class and at one that sees two.
+ * Before all accessors were defined on the template, album.browse() added tracks, review, copyrights and artist
+ * to the single album, so browsed and not browsed albums had different hidden classes.
+ * This does not run the old native code: it redefines these four properties on every other album, which splits
+ * the hidden classes the same way, and compares a site that reads only unchanged albums ("one shape") with a
+ * site that reads changed and unchanged albums alternately ("two shapes", what the old code did to any loop over albums).
+ * Both sites get the same number of albums, are warmed up and run alternately, the medians of the rounds are printed.
+ * Run with node test/bench-accessors.js
+ **/
+var spotify = require('../build/Debug/spotify')();
+var loginData = require('./loginData.js');
+
+spotify.ready(bench);
+spotify.login(loginData.user, loginData.password, false, false);
+
+//every site needs its own code, otherwise both share the inline cache of the property access
+function createSite() {
+  return new Function('albums', 'runs',
+    'var length = 0;' +
+    'for(var i = 0; i < runs; i++) {' +
+    '  for(var j = 0; j < albums.length; j++) {' +
+    '    length += albums[j].name.length;' +
+    '  }' +
+    '}' +
+    'return length;');
+}
+
+function time(site, albums, runs) {
+  var start = process.hrtime();
+  site(albums, runs);
+  var diff = process.hrtime(start);
+  return (diff[0] * 1e9 + diff[1]) / (runs * albums.length);
+}
+
+function median(values) {
+  var sorted = values.slice().sort(function(a, b) { return a - b; });
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function bench() {
+  var playlists = spotify.getPlaylists();
+  var largest = playlists[0];
+  for(var i = 1; i < playlists.length; i++) {
+    if(playlists[i].getTracks().length > largest.getTracks().length) {
+      largest = playlists[i];
+    }
+  }
+  var albums = largest.getTracks().getAlbumsBulk().albums.toArray();
+  console.log(albums.length + ' albums from playlist ' + largest.name);
+
+  //the properties album.browse() used to add, as own properties of every other album
+  ['tracks', 'review', 'copyrights', 'artist'].forEach(function(name) {
+    for(var i = 0; i < albums.length; i += 2) {
+      Object.defineProperty(albums[i], name, { get: function() { return undefined; } });
+    }
+  });
+  var oneShape = albums.filter(function(album, i) { return i % 2 == 1; });
+  var twoShapes = albums.slice(0, oneShape.length);
+
+  var sites = [
+    { name: 'one shape', site: createSite(), albums: oneShape, times: [] },
+    { name: 'two shapes', site: createSite(), albums: twoShapes, times: [] }
+  ];
+  var runs = 1000;
+  sites.forEach(function(site) {
+    time(site.site, site.albums, runs);
+  });
+  for(var round = 0; round < 10; round++) {
+    var order = round % 2 == 0 ? sites : sites.slice().reverse();
+    order.forEach(function(site) {
+      site.times.push(time(site.site, site.albums, runs));
+    });
+  }
+  sites.forEach(function(site) {
+    console.log(site.name + ': ' + median(site.times).toFixed(1) + 'ns per access');
+  });
+  console.log('Speedup: ' + (median(sites[1].times) / median(sites[0].times)).toFixed(2) + 'x');
+
+  spotify.logout();
+}
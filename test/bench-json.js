@@ -0,0 +1,50 @@
+/**
+ * Compares JSON.stringify over the Javascript objects with the native toJSON
+ * on the largest playlist of the account. Run with node test/bench-json.js
+ **/
+var spotify = require('../build/Debug/spotify')();
+var loginData = require('./loginData.js');
+
+spotify.ready(bench);
+spotify.login(loginData.user, loginData.password, false, false);
+
+function time(name, runs, fn) {
+  var result;
+  var start = process.hrtime();
+  for(var i = 0; i < runs; i++) {
+    result = fn();
+  }
+  var diff = process.hrtime(start);
+  var ms = (diff[0] * 1e3 + diff[1] / 1e6) / runs;
+  console.log(name + ': ' + ms.toFixed(2) + 'ms, ' + result.length + ' bytes');
+  return ms;
+}
+
+function bench() {
+  var playlists = spotify.getPlaylists();
+  var largest = playlists[0];
+  for(var i = 1; i < playlists.length; i++) {
+    if(playlists[i].getTracks().length > largest.getTracks().length) {
+      largest = playlists[i];
+    }
+  }
+  console.log('Playlist ' + largest.name + ' with ' + largest.getTracks().length + ' tracks');
+
+  var runs = 10;
+  var stringify = time('JSON.stringify', runs, function() {
+    return JSON.stringify({
+      name: largest.name,
+      link: largest.link,
+      tracks: largest.getTracks().toArray()
+    });
+  });
+  var native = time('toJSON', runs, function() {
+    return largest.toJSON(1);
+  });
+  time('toJSON as Buffer', runs, function() {
+    return largest.toJSON(1, undefined, true);
+  });
+  console.log('Speedup: ' + (stringify / native).toFixed(1) + 'x');
+
+  spotify.logout();
+}
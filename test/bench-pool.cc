@@ -0,0 +1,76 @@
+/**
+ * Creates and releases a synthetic library of tracks through the IdentityMap, once with the slab pools
+ * and once the way it was done before (new plus a std::map with the default allocator).
+ * Build and run with g++ -std=c++11 -O2 -o bench-pool test/bench-pool.cc && ./bench-pool
+ **/
+#include "../src/objects/spotify/IdentityMap.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct sp_fake {
+  int id;
+};
+
+//About the size of a Track: the libspotify pointer, the wrapper pointer and the snapshot.
+class FakeTrack {
+public:
+  FakeTrack(sp_fake* _track) : track(_track), nodeObject(nullptr), snapshot(nullptr) {};
+private:
+  sp_fake* track;
+  void* nodeObject;
+  void* snapshot;
+};
+
+class HeapIdentityMap {
+public:
+  std::shared_ptr<FakeTrack> get(sp_fake* spObject) {
+    auto it = objects.find(spObject);
+    if(it != objects.end()) {
+      std::shared_ptr<FakeTrack> object = it->second.lock();
+      if(object) {
+        return object;
+      }
+    }
+    std::shared_ptr<FakeTrack> object(new FakeTrack(spObject), [this, spObject](FakeTrack* deleted) {
+      auto it = objects.find(spObject);
+      if(it != objects.end() && it->second.expired()) {
+        objects.erase(it);
+      }
+      delete deleted;
+    });
+    objects[spObject] = object;
+    return object;
+  }
+private:
+  std::map<sp_fake*, std::weak_ptr<FakeTrack>> objects;
+};
+
+template <class Map>
+double run(const std::string& name, std::vector<sp_fake>& library, int rounds) {
+  Map map;
+  auto start = std::chrono::steady_clock::now();
+  for(int round = 0; round < rounds; round++) {
+    std::vector<std::shared_ptr<FakeTrack>> tracks;
+    tracks.reserve(library.size());
+    for(size_t i = 0; i < library.size(); i++) {
+      tracks.push_back(map.get(&library[i]));
+    }
+    //teardown when tracks goes out of scope
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  double ms = elapsed.count() / rounds;
+  std::cout << name << ": " << ms << "ms per library" << std::endl;
+  return ms;
+}
+
+int main() {
+  std::vector<sp_fake> library(50000);
+  int rounds = 20;
+  double heap = run<HeapIdentityMap>("new and std::allocator", library, rounds);
+  double pooled = run<IdentityMap<sp_fake, FakeTrack>>("slab pools", library, rounds);
+  std::cout << "Speedup: " << heap / pooled << "x" << std::endl;
+  return 0;
+}
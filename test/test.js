@@ -5,6 +5,8 @@ spotify.ready(tests);
 spotify.login(loginData.user, loginData.password, false, false);
 
 function tests() {
+  console.log('Time to ready: ' + JSON.stringify(spotify.getTimeToReady()));
+
   /* Playlists */
   var playlists = spotify.getPlaylists();
   console.log('Playlists: ' + playlists.length)
@@ -43,6 +45,24 @@ function tests() {
     console.log('Search artists: ' + search.getArtists().length);
     console.log('Search playlists: ' + search.getPlaylists().length);
 
-    spotify.logout();
+    editTests();
+  });
+}
+
+/* Playlist editing with positions from playlistOps, nothing is changed */
+function editTests() {
+  var firstPlaylist = spotify.getPlaylists()[0];
+  var firstTrack = firstPlaylist.getTracks()[0];
+  var noDuplicates = spotify.playlistOps.duplicates([firstTrack], {indices: true});
+  console.log('Duplicates are a Uint32Array: ' + (noDuplicates instanceof Uint32Array) + ', length ' + noDuplicates.length);
+  firstPlaylist.removeTracks(noDuplicates, function(err) {
+    console.log('removeTracks with a Uint32Array: ' + (err ? err.message : 'ok'));
+    var common = spotify.playlistOps.intersect(firstPlaylist, [firstTrack], {indices: true});
+    console.log('Intersection positions: ' + Array.prototype.join.call(common.a, ','));
+    //moves the first track in front of itself
+    firstPlaylist.reorderTracks(common.a, 0, function(err) {
+      console.log('reorderTracks with a Uint32Array: ' + (err ? err.message : 'ok'));
+      spotify.logout();
+    });
   });
 }
\ No newline at end of file